@@ -12,12 +12,7 @@ layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in float a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
 
-struct VertexOutput {
-	vec4 color;
-	vec2 texCoord;
-	float texIndex;
-	float tilingFactor;
-};
+#include "include/Renderer2D.glslh"
 
 layout(location = 0) out VertexOutput vertOut;
 
@@ -32,23 +27,27 @@ void main() {
 
 #type fragment
 #version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
 
-layout(set = 0, binding = 1) uniform sampler2D u_Textures[32];
+// Bindless texture table, indexed by texture ID
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
 
-struct VertexOutput {
-	vec4 color;
-	vec2 texCoord;
-	float texIndex;
-	float tilingFactor;
-};
+#include "include/Renderer2D.glslh"
 
 layout(location = 0) in VertexOutput vertIn;
 
 layout(location = 0) out vec4 o_Color;
 
+// Chosen when the pipeline is created, see Renderer2DSpecification::alphaCutoff
+layout(constant_id = 0) const bool c_AlphaTest = false;
+layout(constant_id = 1) const float c_AlphaCutoff = 0.5;
+
 
 void main() {
-    o_Color = texture(u_Textures[int(vertIn.texIndex)], vertIn.texCoord * vertIn.tilingFactor) * vertIn.color;
+    o_Color = texture(u_Textures[nonuniformEXT(int(vertIn.texIndex))], vertIn.texCoord * vertIn.tilingFactor) * vertIn.color;
+    if (c_AlphaTest && o_Color.a < c_AlphaCutoff) {
+        discard;
+    }
 }
 
 
@@ -0,0 +1,74 @@
+#type vertex
+#version 450 core
+
+layout(set = 0, binding = 0) uniform CameraData {
+	mat4 viewProjection;
+} u_Camera;
+
+
+// Per-instance attributes: one record per quad.
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_Size;
+layout(location = 2) in float a_Rotation;  // Radians
+layout(location = 3) in vec4 a_Color;
+layout(location = 4) in float a_TexIndex;
+layout(location = 5) in float a_TilingFactor;
+
+#include "include/Renderer2D.glslh"
+
+layout(location = 0) out VertexOutput vertOut;
+
+// The corners follow the quad index buffer of Renderer2D: 0, 1, 2, 2, 3, 0
+const vec2 c_Corners[4] = vec2[](
+	vec2(-0.5, -0.5),
+	vec2( 0.5, -0.5),
+	vec2( 0.5,  0.5),
+	vec2(-0.5,  0.5)
+);
+
+const vec2 c_TexCoords[4] = vec2[](
+	vec2(0.0, 0.0),
+	vec2(1.0, 0.0),
+	vec2(1.0, 1.0),
+	vec2(0.0, 1.0)
+);
+
+void main() {
+	vec2 corner = c_Corners[gl_VertexIndex] * a_Size;
+
+	float s = sin(a_Rotation);
+	float c = cos(a_Rotation);
+	vec2 rotated = vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y);
+
+    gl_Position = u_Camera.viewProjection * vec4(a_Position + vec3(rotated, 0.0), 1.0);
+	vertOut.color = a_Color;
+	vertOut.texCoord = c_TexCoords[gl_VertexIndex];
+	vertOut.texIndex = a_TexIndex;
+	vertOut.tilingFactor = a_TilingFactor;
+}
+
+
+#type fragment
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Bindless texture table, indexed by texture ID
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+#include "include/Renderer2D.glslh"
+
+layout(location = 0) in VertexOutput vertIn;
+
+layout(location = 0) out vec4 o_Color;
+
+// Chosen when the pipeline is created, see Renderer2DSpecification::alphaCutoff
+layout(constant_id = 0) const bool c_AlphaTest = false;
+layout(constant_id = 1) const float c_AlphaCutoff = 0.5;
+
+
+void main() {
+    o_Color = texture(u_Textures[nonuniformEXT(int(vertIn.texIndex))], vertIn.texCoord * vertIn.tilingFactor) * vertIn.color;
+    if (c_AlphaTest && o_Color.a < c_AlphaCutoff) {
+        discard;
+    }
+}
@@ -35,14 +35,16 @@ public:
 
         m_Renderer2D->beginScene(*m_Camera);
         {
+            m_Grid.clear();
             for (float y = -10.0f; y < 10.0f; y += 0.5f)
             {
                 for (float x = -10.0f; x < 10.0f; x += 0.5f)
                 {
                     glm::vec4 color = { (x + 10.0f) / 20.0f, 0.4f, (y + 10.0f) / 20.0f, 1.0f };
-                    m_Renderer2D->drawQuad({ x, y, -8.0f }, { 0.45f, 0.45f }, color);
+                    m_Grid.push_back({ .position = { x, y, -8.0f }, .size = { 0.45f, 0.45f }, .color = color });
                 }
             }
+            m_Renderer2D->drawQuads(m_Grid);
 
             m_Renderer2D->drawQuad({ -1.8f, 0.4f, -3.0f }, { 2.2f, 2.5f }, { 0.2f, 0.3f, 0.8f, 1.0f });
             m_Renderer2D->drawRotatedQuad({ 1.9f, -0.7f, 0.0f }, { 1.4f, 1.8f }, -30.0f, { 0.3f, 0.8f, 0.2f, 1.0f });
@@ -60,6 +62,7 @@ public:
 
 private:
     Astranox::Ref<Astranox::Renderer2D> m_Renderer2D;
+    std::vector<Astranox::QuadDesc> m_Grid;
 
     Astranox::ShaderLibrary m_ShaderLibrary;
     Astranox::Ref<Astranox::PerspectiveCamera> m_Camera = nullptr;
@@ -29,6 +29,15 @@ project "Astranox-Rasterization"
             "AST_PLATFORM_WINDOWS"
         }
 
+	filter "system:linux"
+		defines {
+            "AST_PLATFORM_LINUX",
+        }
+		links {
+			"pthread",
+			"dl",
+		}
+
 	filter "configurations:Debug"
 		symbols "On"
 		defines {
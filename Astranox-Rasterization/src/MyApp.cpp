@@ -1,4 +1,5 @@
 #include <Astranox.hpp>
+#include <charconv>
 //
 //#include "TempLayer.hpp"
 //#include "Sandbox.hpp"
@@ -18,14 +19,37 @@ public:
     virtual ~MyApp() = default;
 };
 
-Astranox::Application* Astranox::createApplication()
+Astranox::Application* Astranox::createApplication(Astranox::ApplicationCommandLineArgs args)
 {
     Astranox::ApplicationSpecification appSpec;
     appSpec.name = "Astranox | Real-time Rasterization";
     appSpec.windowWidth = 1440;
     appSpec.windowHeight = 900;
-    appSpec.vsync = true;
+    appSpec.presentPolicy = Astranox::PresentPolicy::LowLatency;
     appSpec.workingDirectory = std::filesystem::current_path();
+    appSpec.commandLineArgs = args;
+
+    // Usage: Astranox-Rasterization [--headless] [--frames <count>]
+    for (int i = 1; i < args.count; i++)
+    {
+        std::string_view arg = args[i];
+        if (arg == "--headless")
+        {
+            appSpec.headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < args.count)
+        {
+            std::string_view count = args[++i];
+            uint64_t maxFrames = 0;
+            auto [end, error] = std::from_chars(count.data(), count.data() + count.size(), maxFrames);
+            if (error != std::errc() || end != count.data() + count.size())
+            {
+                AST_ERROR("Invalid frame count: {0}", count);
+                continue;
+            }
+            appSpec.maxFrames = maxFrames;
+        }
+    }
 
     return new MyApp(appSpec);
 }
\ No newline at end of file
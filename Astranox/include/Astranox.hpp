@@ -11,10 +11,13 @@
 #include "Astranox/rendering/Renderer2D.hpp"
 #include "Astranox/rendering/Mesh.hpp"
 #include "Astranox/rendering/VertexBufferLayout.hpp"
+#include "Astranox/rendering/StorageBuffer.hpp"
 
 #include "Astranox/platform/vulkan/VulkanContext.hpp"
 #include "Astranox/platform/vulkan/VulkanTexture2D.hpp"
 #include "Astranox/platform/vulkan/VulkanRenderer.hpp"
+#include "Astranox/platform/vulkan/VulkanComputePipeline.hpp"
+#include "Astranox/platform/vulkan/VulkanImage2D.hpp"
 #include "Astranox/platform/vulkan/VulkanShaderCompiler.hpp"
 #include "Astranox/platform/vulkan/VulkanUniformBufferArray.hpp"
 
@@ -2,18 +2,46 @@
 #include "Window.hpp"
 #include "LayerStack.hpp"
 #include "Timestep.hpp"
+#include "Timer.hpp"
 #include "events/ApplicationEvent.hpp"
 
 namespace Astranox
 {
 
+    struct ApplicationCommandLineArgs final
+    {
+        int count = 0;
+        char** args = nullptr;
+
+        const char* operator[](int index) const
+        {
+            AST_CORE_ASSERT(index < count, "Command line argument index out of range!");
+            return args[index];
+        }
+    };
+
     struct ApplicationSpecification final
     {
         std::string name = "Astranox";
         uint32_t windowWidth = 1440;
         uint32_t windowHeight = 900;
-        bool vsync = true;
+        PresentPolicy presentPolicy = PresentPolicy::LowLatency;
         std::filesystem::path workingDirectory;
+
+        // Render into engine-owned offscreen images instead of a window surface.
+        // No display server is required, so this also runs on render nodes and CPU ICDs (e.g. lavapipe).
+        bool headless = false;
+        // Stop after this many frames (0: run until closed). Mostly useful for headless benchmarks.
+        uint64_t maxFrames = 0;
+
+        // Number of frames the CPU may record ahead of the GPU, independent of the swapchain image count.
+        // Each one gets its own copy of per-frame resources (command buffers, uniform buffers, descriptor sets).
+        uint32_t framesInFlight = 2;
+
+        // Recompile shaders while the application runs when their source files change. Meant for development.
+        bool shaderHotReload = false;
+
+        ApplicationCommandLineArgs commandLineArgs;
     };
 
     /**
@@ -30,6 +58,10 @@ namespace Astranox
          * This function is called by the engine.
          */
         virtual void run() final;
+        /**
+         * Request the application to stop after the current frame.
+         */
+        virtual void close() final;
 
         virtual void onEvent(Event& evnt) final;
 
@@ -37,6 +69,7 @@ namespace Astranox
         inline static Application& get() { return *s_Instance; }
         inline virtual Window& getWindow() const final { return *m_Window; }
 
+        inline const ApplicationSpecification& getSpecification() const { return m_Specification; }
         inline uint32_t getCurrentFrameIndex() const { return m_CurrentFrameIndex; }
 
     public: // Layer management
@@ -49,6 +82,7 @@ namespace Astranox
 
     private:
         inline static Application* s_Instance = nullptr;
+        ApplicationSpecification m_Specification;
         bool m_Running = true;
 
         std::unique_ptr<Window> m_Window = nullptr;
@@ -56,9 +90,11 @@ namespace Astranox
 
         LayerStack m_LayerStack;
 
+        Timer m_Timer;
         Timestep m_Timestep;
         float m_LastFrameTime = 0.0f;
         uint32_t m_CurrentFrameIndex = 0;
+        uint64_t m_FrameCount = 0;
     };
 
     /**
@@ -66,6 +102,6 @@ namespace Astranox
      *  (1) Inherit from the `Application` class.
      *  (2) Implement the `createApplication` function in your own project (simply return a pointer to your application instance).
      */
-    Application* createApplication();
+    Application* createApplication(ApplicationCommandLineArgs args);
 
 }
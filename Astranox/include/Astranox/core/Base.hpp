@@ -7,9 +7,18 @@
     #define AST_ENABLE_ASSERTS
 #endif
 
+#if defined(AST_PLATFORM_WINDOWS)
+    #define AST_DEBUGBREAK() __debugbreak()
+#elif defined(AST_PLATFORM_LINUX)
+    #include <csignal>
+    #define AST_DEBUGBREAK() std::raise(SIGTRAP)
+#else
+    #define AST_DEBUGBREAK()
+#endif
+
 #ifdef AST_ENABLE_ASSERTS
-    #define AST_ASSERT(x, ...) { if(!(x)) { AST_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-    #define AST_CORE_ASSERT(x, ...) { if(!(x)) { AST_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+    #define AST_ASSERT(x, ...) { if(!(x)) { AST_ERROR("Assertion Failed: {0}", __VA_ARGS__); AST_DEBUGBREAK(); } }
+    #define AST_CORE_ASSERT(x, ...) { if(!(x)) { AST_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); AST_DEBUGBREAK(); } }
 #else
     #define AST_ASSERT(x, ...)
     #define AST_CORE_ASSERT(x, ...)
@@ -7,15 +7,15 @@
  */
 
 
-#ifdef AST_PLATFORM_WINDOWS
+#if defined(AST_PLATFORM_WINDOWS) || defined(AST_PLATFORM_LINUX)
 
-    extern Astranox::Application* Astranox::createApplication();
+    extern Astranox::Application* Astranox::createApplication(Astranox::ApplicationCommandLineArgs args);
 
     int main(int argc, char** argv)
     {
         Astranox::Logging::init();
 
-        Astranox::Application* app = Astranox::createApplication();
+        Astranox::Application* app = Astranox::createApplication({ argc, argv });
         app->run();
         delete app;
 
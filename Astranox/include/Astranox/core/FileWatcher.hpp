@@ -0,0 +1,44 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace Astranox
+{
+    /**
+     * Detects modifications of a set of files by polling their last write time.
+     *
+     * Polling is portable and costs one stat per file and interval, which is negligible for the handful of files
+     * a running application iterates on (e.g. shader sources).
+     */
+    class FileWatcher
+    {
+    public:
+        FileWatcher(std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+        ~FileWatcher() = default;
+
+        /**
+         * @brief Start watching `filepath`. Watching a file twice keeps its state, so no change is lost in between.
+         */
+        void watch(const std::filesystem::path& filepath);
+        void unwatch(const std::filesystem::path& filepath);
+        void unwatchAll() { m_Files.clear(); }
+
+        /**
+         * @brief Files that have been written since the previous call. At most one check per interval is made.
+         * A file that is missing (e.g. in the middle of being saved) is reported once it reappears.
+         */
+        std::vector<std::filesystem::path> poll();
+
+        bool isWatching() const { return !m_Files.empty(); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::chrono::milliseconds m_Interval;
+        Clock::time_point m_LastPollTime;
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_Files;  // [path, last write time]
+    };
+}
@@ -1,10 +1,12 @@
 #pragma once
+#include <atomic>
 
 namespace Astranox
 {
     /**
      * A reference-counted object.
      * This class is used to manage the lifetime of objects.
+     * The count is atomic, so references may be copied and dropped on worker threads.
      */
     class RefCounted
     {
@@ -12,10 +14,14 @@ namespace Astranox
         RefCounted() = default;
         virtual ~RefCounted() = default;
 
+        // A copy is a new object, so it starts without references.
+        RefCounted(const RefCounted&) {}
+        RefCounted& operator=(const RefCounted&) { return *this; }
+
         /**
          * Increment the reference count.
          */
-        void addRef() { m_RefCount++; }
+        void addRef() { m_RefCount.fetch_add(1, std::memory_order_relaxed); }
 
         /**
          * Decrement the reference count.
@@ -23,17 +29,17 @@ namespace Astranox
          */
         void releaseRef()
         {
-            m_RefCount--;
-            if (m_RefCount == 0)
+            // [NOTE] acq_rel makes every write through other references visible to the thread that deletes.
+            if (m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
             {
                 delete this;
             }
         }
 
-        uint32_t getRefCount() const { return m_RefCount; }
+        uint32_t getRefCount() const { return m_RefCount.load(std::memory_order_relaxed); }
 
     private:
-        uint32_t m_RefCount = 0;
+        std::atomic<uint32_t> m_RefCount = 0;
     };
 
 
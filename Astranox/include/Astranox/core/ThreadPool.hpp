@@ -0,0 +1,72 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <thread>
+
+namespace Astranox
+{
+    /**
+     * A fixed set of worker threads consuming a FIFO task queue.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param threadCount Number of workers. 0 picks one less than the hardware concurrency (at least one),
+         *                    leaving a core for the main thread.
+         */
+        ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queue `task` and return a future for its result.
+         */
+        template<typename F>
+        auto submit(F&& task) -> std::future<std::invoke_result_t<F>>
+        {
+            using Result = std::invoke_result_t<F>;
+
+            // [NOTE] std::function has to be copyable, but std::packaged_task is move-only.
+            auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            std::future<Result> future = packagedTask->get_future();
+            {
+                std::scoped_lock lock(m_Mutex);
+                m_Tasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+            }
+            m_TaskAvailable.notify_one();
+
+            return future;
+        }
+
+        /**
+         * @brief Block until the queue is empty and no task is running.
+         */
+        void waitIdle();
+
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+        /**
+         * @brief Whether the calling thread is a worker of any pool. Tasks use this to avoid waiting on their own pool.
+         */
+        static bool isWorkerThread() { return s_IsWorkerThread; }
+
+    private:
+        void workerLoop();
+
+    private:
+        inline static thread_local bool s_IsWorkerThread = false;
+
+        std::vector<std::thread> m_Workers;
+        std::deque<std::function<void()>> m_Tasks;
+        uint32_t m_RunningTaskCount = 0;
+        bool m_Stopping = false;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_TaskAvailable;
+        std::condition_variable m_Idle;
+    };
+}
@@ -4,12 +4,25 @@
 
 namespace Astranox
 {
+    /**
+     * How rendered frames are handed over to the display.
+     * Modes the surface does not support fall back to the next candidate, and finally to FIFO (always available).
+     */
+    enum class PresentPolicy
+    {
+        LowLatency,  // Tear-free, the newest frame replaces the queued one (MAILBOX -> FIFO)
+        Throughput,  // One more image to keep the GPU busy, late frames may tear (FIFO_RELAXED -> FIFO)
+        VSync,       // Tear-free, capped at the refresh rate (FIFO)
+        Uncapped,    // No synchronization with the display, may tear (IMMEDIATE -> MAILBOX -> FIFO)
+    };
+
     struct WindowSpecification final
     {
         std::string title = "Astranox";
         uint32_t width = 1440;
         uint32_t height = 900;
-        bool vsync = true;
+        PresentPolicy presentPolicy = PresentPolicy::LowLatency;
+        bool headless = false;
     };
 
     /**
@@ -34,7 +47,10 @@ namespace Astranox
 
         virtual void pollEvents() = 0;
 
-        virtual void beginFrame() = 0;
+        /**
+         * @return False if the frame has to be skipped, e.g. while the swapchain cannot be recreated.
+         */
+        virtual bool beginFrame() = 0;
         virtual void swapBuffers() = 0;
 
     public:
@@ -45,8 +61,24 @@ namespace Astranox
         virtual uint32_t getHeight() const = 0;
         virtual std::pair<uint32_t, uint32_t> getSize() const = 0;
 
-        virtual void setVSync(bool enable) = 0;
-        virtual inline bool isVSync() const = 0;
+        /**
+         * @brief Takes effect from the next frame. The swapchain is recreated without waiting for the device to go idle.
+         */
+        virtual void setPresentPolicy(PresentPolicy policy) = 0;
+        virtual PresentPolicy getPresentPolicy() const = 0;
+
+        /**
+         * @brief Every policy other than Uncapped waits for the display (Throughput only when a frame is late).
+         * Switching to the state already in effect keeps the current policy, so `setVSync(isVSync())` never changes it.
+         */
+        void setVSync(bool enable)
+        {
+            if (enable != isVSync())
+            {
+                setPresentPolicy(enable ? PresentPolicy::VSync : PresentPolicy::Uncapped);
+            }
+        }
+        bool isVSync() const { return getPresentPolicy() != PresentPolicy::Uncapped; }
 
         virtual void setEventCallback(const EventCallbackFn& callback) = 0;
 
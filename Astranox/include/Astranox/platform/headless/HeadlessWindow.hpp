@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Astranox/core/Window.hpp"
+
+#include "Astranox/rendering/GraphicsContext.hpp"
+
+namespace Astranox
+{
+    /**
+     * A window without a display.
+     * Frames are rendered into offscreen images owned by the graphics context,
+     * so no windowing system (and no GLFW) is involved.
+     */
+    class HeadlessWindow final: public Window
+    {
+    public:
+        HeadlessWindow(const WindowSpecification& spec);
+        virtual ~HeadlessWindow() = default;
+
+        void init() override;
+        void destroy() override;
+
+    public:
+        void onResize(uint32_t width, uint32_t height) override;
+
+        bool beginFrame() override;
+
+        void pollEvents() override {}
+        void swapBuffers() override;
+
+        // [NOTE] Nothing is presented, so the policy is only recorded.
+        void setPresentPolicy(PresentPolicy policy) override { m_Data.presentPolicy = policy; }
+        PresentPolicy getPresentPolicy() const override { return m_Data.presentPolicy; }
+
+        void setEventCallback(const EventCallbackFn& callback) override { m_Data.eventCallback = callback; }
+
+    public: // Getters
+        void* getHandle() override { return nullptr; }
+
+        const std::string& getTitle() const override { return m_Data.title; }
+        uint32_t getWidth() const override { return m_Data.width; }
+        uint32_t getHeight() const override { return m_Data.height; }
+        std::pair<uint32_t, uint32_t> getSize() const override { return { m_Data.width, m_Data.height }; }
+
+        Ref<GraphicsContext> getGraphicsContext() const { return m_Context; }
+
+    private: // Input
+        // [NOTE] There is no input device in headless mode, so everything reports as released.
+        virtual MouseButtonState getMouseButtonState(MouseButton button) override { return MouseButtonState::Released; }
+        virtual KeyState getKeyState(Key key) override { return KeyState::Released; }
+        virtual glm::vec2 getCursorPosition() override { return glm::vec2{ 0.0f }; }
+
+        virtual void setCursorMode(CursorMode mode) override {}
+
+    private:
+        struct WindowData final
+        {
+            std::string title;
+            uint32_t width;
+            uint32_t height;
+
+            PresentPolicy presentPolicy;
+            EventCallbackFn eventCallback;
+        };
+        WindowData m_Data;
+
+        Ref<GraphicsContext> m_Context = nullptr;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace Astranox
+{
+    class VulkanDevice;
+
+    /**
+     * Engine-wide table of every live texture, bound as one large descriptor array (`u_Textures[]` at set 1).
+     * A texture is written into the table once, at the index of its ID (see Texture2D::getID),
+     * so draws only carry that index and nothing has to be rewritten per frame.
+     *
+     * [NOTE] The descriptor of a destroyed texture stays in the table until its ID is reused.
+     *      This is valid because the binding is PARTIALLY_BOUND and nothing indexes it anymore.
+     *      IDs are only reused once the frames in flight that may still sample the old descriptor have completed,
+     *      since UPDATE_UNUSED_WHILE_PENDING does not allow rewriting an element a pending command buffer uses.
+     */
+    class VulkanBindlessTextureRegistry final: public RefCounted
+    {
+    public:
+        static constexpr uint32_t s_SetIndex = 1;
+        static constexpr uint32_t s_Binding = 0;
+        static constexpr uint32_t s_MaxTextures = 4096;
+        static constexpr uint32_t s_InvalidIndex = UINT32_MAX;
+
+    public:
+        VulkanBindlessTextureRegistry(Ref<VulkanDevice> device);
+        ~VulkanBindlessTextureRegistry() = default;
+
+        void destroy();
+
+    public:
+        /**
+         * @brief Reserve an element of the table.
+         * @return The index of the element, or s_InvalidIndex if the table is full.
+         */
+        uint32_t allocateIndex();
+
+        /**
+         * @brief Give an element back. It is reused through the deletion queue, i.e. `framesInFlight` frames later.
+         */
+        void releaseIndex(uint32_t index);
+
+        /**
+         * @brief Write the descriptor of a texture into the table.
+         * Safe to call while command buffers using the table are recorded or pending.
+         */
+        void registerTexture(uint32_t index, const VkDescriptorImageInfo& imageInfo);
+
+    public:
+        uint32_t getCapacity() const { return m_Capacity; }
+
+        VkDescriptorSetLayout getDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+        VkDescriptorSet getDescriptorSet() const { return m_DescriptorSet; }
+
+    private:
+        Ref<VulkanDevice> m_Device = nullptr;
+
+        uint32_t m_Capacity = 0;
+
+        VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+
+        std::vector<uint32_t> m_FreeIndices;
+        uint32_t m_NextIndex = 0;
+
+        std::mutex m_Mutex;  // Descriptor set updates must be externally synchronized
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include "VulkanShader.hpp"
+
+namespace Astranox
+{
+    class VulkanComputePipeline: public RefCounted
+    {
+    public:
+        VulkanComputePipeline(Ref<Shader> shader);
+        virtual ~VulkanComputePipeline();
+
+    public:
+        VkPipeline getRaw() { return m_Pipeline; }
+        VkPipelineLayout getLayout() { return m_PipelineLayout; }
+
+        Ref<Shader> getShader() { return m_Shader; }
+
+    private:
+        void init();
+
+    private:
+        Ref<Shader> m_Shader = nullptr;
+
+        VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+        VkPipeline m_Pipeline = VK_NULL_HANDLE;
+    };
+}
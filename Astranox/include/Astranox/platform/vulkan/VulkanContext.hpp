@@ -6,13 +6,16 @@
 #include "VulkanPhysicalDevice.hpp"
 #include "VulkanDevice.hpp"
 #include "VulkanSwapchain.hpp"
+#include "VulkanBindlessTextureRegistry.hpp"
+#include "VulkanUploadManager.hpp"
+#include "VulkanDeletionQueue.hpp"
 
 namespace Astranox 
 {
     class VulkanContext final : public GraphicsContext
     {
     public:
-        VulkanContext() = default;
+        VulkanContext(bool headless = false);
         virtual ~VulkanContext() = default;
 
         /**
@@ -38,6 +41,11 @@ namespace Astranox
         Ref<VulkanPhysicalDevice> getPhysicalDevice() { return m_PhysicalDevice; }
         Ref<VulkanDevice> getDevice() { return m_Device; }
         Ref<VulkanSwapchain> getSwapchain() { return m_Swapchain; }
+        Ref<VulkanBindlessTextureRegistry> getBindlessTextureRegistry() { return m_BindlessTextureRegistry; }
+        Ref<VulkanUploadManager> getUploadManager() { return m_UploadManager; }
+        Ref<VulkanDeletionQueue> getDeletionQueue() { return m_DeletionQueue; }
+
+        bool isHeadless() const { return m_Headless; }
 
     private:
         void createInstance();
@@ -46,11 +54,17 @@ namespace Astranox
     private:
         inline static VkInstance s_Instance = VK_NULL_HANDLE;
 
+        bool m_Headless = false;
+
         VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;  // Available only in debug mode
 
         Ref<VulkanPhysicalDevice> m_PhysicalDevice = nullptr;
         Ref<VulkanDevice> m_Device = nullptr;
 
         Ref<VulkanSwapchain> m_Swapchain = nullptr;
+
+        Ref<VulkanBindlessTextureRegistry> m_BindlessTextureRegistry = nullptr;
+        Ref<VulkanUploadManager> m_UploadManager = nullptr;
+        Ref<VulkanDeletionQueue> m_DeletionQueue = nullptr;
     };
 }
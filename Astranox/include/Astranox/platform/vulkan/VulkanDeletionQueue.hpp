@@ -0,0 +1,50 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include <deque>
+#include <functional>
+
+namespace Astranox
+{
+    /**
+     * Defers the destruction of Vulkan objects until the GPU can no longer be using them.
+     *
+     * Every deleter is tagged with the number of the latest frame that has begun.
+     * That frame (and every earlier one) has completed once the fence of its frame slot has been waited on again,
+     * i.e. `framesInFlight` frames later, so the deleter runs in that frame's beginFrame().
+     */
+    class VulkanDeletionQueue final: public RefCounted
+    {
+    public:
+        VulkanDeletionQueue() = default;
+        ~VulkanDeletionQueue() = default;
+
+        void destroy();
+
+    public:
+        void push(std::function<void()>&& deleter);
+
+        /**
+         * @brief Start a new frame and run the deleters of every frame that has completed.
+         * Must be called after the fence of the current frame slot has been waited on.
+         */
+        void beginFrame();
+
+        /**
+         * @brief Run every pending deleter. The device must be idle.
+         */
+        void flush();
+
+    private:
+        struct Entry
+        {
+            uint64_t frame = 0;
+            std::function<void()> deleter;
+        };
+
+        std::deque<Entry> m_Entries;  // In push order, so frame numbers are non-decreasing
+        uint64_t m_FrameNumber = 0;
+
+        std::mutex m_Mutex;
+    };
+}
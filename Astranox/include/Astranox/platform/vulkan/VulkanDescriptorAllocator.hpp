@@ -0,0 +1,130 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace Astranox
+{
+    /**
+     * Device-level descriptor set allocator.
+     *
+     * Sets come from chains of small pools, and a new (larger) pool is appended whenever the current ones run out.
+     *  - Persistent sets live until they are freed, e.g. the sets of a VulkanDescriptorManager.
+     *  - Transient sets live for one frame: the pools of a frame slot are reset wholesale
+     *    once the fence of that frame has signaled (see VulkanSwapchain::beginFrame).
+     * A set that needs more descriptors of some type than a pool reserves gets a dedicated pool of its own.
+     */
+    class VulkanDescriptorAllocator final: public RefCounted
+    {
+    public:
+        struct DescriptorUsage
+        {
+            uint32_t capacity = 0;
+            uint32_t used = 0;
+
+            float getUtilization() const { return capacity ? (float)used / capacity : 0.0f; }
+        };
+
+        struct Statistics
+        {
+            uint32_t poolCount = 0;
+            uint32_t setCount = 0;
+            uint32_t setCapacity = 0;
+
+            uint32_t transientPoolCount = 0;  // Over all frame slots
+            uint32_t transientSetCount = 0;
+            uint32_t transientSetCapacity = 0;
+
+            uint32_t dedicatedPoolCount = 0;  // One set each, persistent and transient
+
+            // Descriptors of the shared pools by type. A pool can run out of one type while it still has free sets.
+            std::map<VkDescriptorType, DescriptorUsage> descriptors;
+            std::map<VkDescriptorType, DescriptorUsage> transientDescriptors;
+
+            float getUtilization() const { return setCapacity ? (float)setCount / setCapacity : 0.0f; }
+            float getTransientUtilization() const { return transientSetCapacity ? (float)transientSetCount / transientSetCapacity : 0.0f; }
+        };
+
+    public:
+        VulkanDescriptorAllocator(VkDevice device);
+        ~VulkanDescriptorAllocator() = default;
+
+        void destroy();
+
+    public:
+        /**
+         * @brief Allocate a set of `layout`, whose bindings need `poolSizes` descriptors.
+         */
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes);
+        void free(VkDescriptorSet descriptorSet);
+
+        /**
+         * @brief Allocate a set that is valid until the frame slot `frameIndex` is reset. It is never freed on its own.
+         */
+        VkDescriptorSet allocateTransient(uint32_t frameIndex, VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes);
+
+        /**
+         * @brief Release every transient set of a frame slot. The frame must no longer be in flight.
+         */
+        void resetFrame(uint32_t frameIndex);
+
+        Statistics getStats() const;
+
+    private:
+        struct Pool
+        {
+            VkDescriptorPool pool = VK_NULL_HANDLE;
+            uint32_t capacity = 0;
+            uint32_t allocated = 0;
+
+            std::map<VkDescriptorType, uint32_t> descriptorCapacity;
+            std::map<VkDescriptorType, uint32_t> descriptorsUsed;
+        };
+
+        struct PoolChain
+        {
+            std::vector<Pool> pools;
+            uint32_t currentPool = 0;  // Pools before it are known to be out of sets
+        };
+
+        struct FramePools
+        {
+            PoolChain chain;
+            std::vector<VkDescriptorPool> dedicatedPools;  // Destroyed when the frame slot is reset
+        };
+
+        Pool createPool(uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPoolCreateFlags flags);
+        VkDescriptorSet allocateFromChain(PoolChain& chain, VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes,
+            VkDescriptorPoolCreateFlags flags, uint32_t& poolIndex);
+        VkDescriptorSet allocateDedicated(VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPool& pool);
+        /**
+         * @brief Move the cursor of `chain` past the pools that are out of sets.
+         */
+        static void advanceCursor(PoolChain& chain);
+
+        /**
+         * @brief Whether a set needing `poolSizes` fits into a pool sized by the descriptor ratios.
+         */
+        static bool fitsSharedPool(const std::vector<VkDescriptorPoolSize>& poolSizes);
+
+    private:
+        static constexpr uint32_t s_InitialSetsPerPool = 64;
+        static constexpr uint32_t s_MaxSetsPerPool = 4096;
+
+        VkDevice m_Device = VK_NULL_HANDLE;
+
+        PoolChain m_Pools;
+        struct SetOwner
+        {
+            uint32_t poolIndex = 0;
+            std::vector<VkDescriptorPoolSize> descriptors;  // Returned to the pool when the set is freed
+        };
+        std::unordered_map<VkDescriptorSet, SetOwner> m_SetOwners;
+
+        std::unordered_map<VkDescriptorSet, VkDescriptorPool> m_DedicatedPools;  // [set, its pool]
+
+        std::vector<FramePools> m_FramePools;  // Grows with the frame indices seen
+
+        mutable std::mutex m_Mutex;
+    };
+}
@@ -6,6 +6,8 @@
 #include "Astranox/rendering/UniformBufferArray.hpp"
 #include "Astranox/rendering/Shader.hpp"
 #include "Astranox/rendering/Texture2D.hpp"
+#include "Astranox/rendering/StorageBuffer.hpp"
+#include "VulkanImage2D.hpp"
 
 namespace Astranox
 {
@@ -14,14 +16,18 @@ namespace Astranox
         None = 0,
         UniformBuffer,
         UniformBufferArray,
-        Texture2D
+        Texture2D,
+        StorageBuffer,
+        Image2D
     };
 
     enum class RenderPassInputType: uint8_t
     {
         None = 0,
         UniformBuffer,
-        ImageSampler2D
+        ImageSampler2D,
+        StorageBuffer,
+        StorageImage2D
     };
 
     struct RenderPassInput
@@ -49,6 +55,18 @@ namespace Astranox
             input.push_back(texture);
         }
 
+        RenderPassInput(Ref<StorageBuffer> sb)
+            : type(RenderPassResourceType::StorageBuffer)
+        {
+            input.push_back(sb);
+        }
+
+        RenderPassInput(Ref<VulkanImage2D> image)
+            : type(RenderPassResourceType::Image2D)
+        {
+            input.push_back(image);
+        }
+
         void setInput(Ref<UniformBuffer> ub, uint32_t index)
         {
             type = RenderPassResourceType::UniformBuffer;
@@ -66,6 +84,18 @@ namespace Astranox
             type = RenderPassResourceType::Texture2D;
             input[index] = texture;
         }
+
+        void setInput(Ref<StorageBuffer> sb, uint32_t index)
+        {
+            type = RenderPassResourceType::StorageBuffer;
+            input[index] = sb;
+        }
+
+        void setInput(Ref<VulkanImage2D> image, uint32_t index)
+        {
+            type = RenderPassResourceType::Image2D;
+            input[index] = image;
+        }
     };
 
     struct RenderPassInputDeclaration
@@ -80,12 +110,21 @@ namespace Astranox
     class VulkanDescriptorManager: public RefCounted
     {
     public:
-        VulkanDescriptorManager(Ref<Shader> shader);
+        /**
+         * @param transient Allocate the sets from the frame's transient pools on every upload() and write them in full,
+         * instead of keeping persistent sets per frame slot. Suits sets that are rewritten every frame anyway.
+         */
+        VulkanDescriptorManager(Ref<Shader> shader, bool transient = false);
         virtual ~VulkanDescriptorManager();
 
+        /**
+         * @brief Write the bindings that changed since the current frame slot was last uploaded.
+         * Persistent sets are allocated once and updated in place, so call this every frame before they are bound:
+         * the sets of a frame slot are only touched while that frame is not in flight.
+         * Transient sets are allocated anew by every call and are only valid for the current frame.
+         */
         void upload();
 
-        VkDescriptorPool getDescriptorPool() const { return m_DescriptorPool; }
         const std::vector<VkDescriptorSet>& getDescriptorSets(uint32_t frameIndex) const { 
             return m_DescriptorSets[frameIndex];
         }
@@ -95,15 +134,24 @@ namespace Astranox
         void setInput(const std::string& name, Ref<UniformBuffer> ub);
         void setInput(const std::string& name, Ref<UniformBufferArray> uba);
         void setInput(const std::string& name, Ref<Texture2D> texture, uint32_t index);
+        void setInput(const std::string& name, Ref<StorageBuffer> sb);
+        void setInput(const std::string& name, Ref<VulkanImage2D> image, uint32_t index = 0);
+
+    private:
+        void allocateDescriptorSets();
+        void allocateTransientDescriptorSets(uint32_t frameIndex);
+        void markDirty(uint32_t set, uint32_t binding);
 
     private:
         std::map<uint32_t, std::map<uint32_t, RenderPassInput>> m_RenderPassInputResources;  // [set, [binding, input]]
         std::map<std::string, RenderPassInputDeclaration> m_RenderPassInputDeclarations;
         std::vector<std::map<uint32_t, std::map<uint32_t, VkWriteDescriptorSet>>> m_WriteDescriptorMap;  // [frame, [set, [binding, wd]]]
 
-        VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
-        std::vector<std::vector<VkDescriptorSet>> m_DescriptorSets;
+        std::vector<std::map<uint32_t, std::set<uint32_t>>> m_DirtyBindings;  // [frame, [set, bindings]]
+
+        std::vector<std::vector<VkDescriptorSet>> m_DescriptorSets;  // [frame, set], from the device's descriptor allocator
 
         Ref<Shader> m_Shader = nullptr;
+        bool m_Transient = false;
     };
 }
@@ -1,13 +1,20 @@
 #pragma once
 #include "VulkanPhysicalDevice.hpp"
 #include "VulkanCommandBuffer.hpp"
+#include "VulkanDescriptorAllocator.hpp"
+#include "VulkanPipelineCache.hpp"
+
+#include <atomic>
 
 namespace Astranox
 {
     class VulkanDevice final: public RefCounted
     {
     public:
-        VulkanDevice(const Ref<VulkanPhysicalDevice>& physicalDevice);
+        /**
+         * @param headless Skip the swapchain extension, which is only needed for presenting.
+         */
+        VulkanDevice(const Ref<VulkanPhysicalDevice>& physicalDevice, bool headless = false);
         ~VulkanDevice() = default;
 
         void destroy();
@@ -23,6 +30,9 @@ namespace Astranox
             return m_CommandPool;
         }
 
+        Ref<VulkanDescriptorAllocator> getDescriptorAllocator() { return m_DescriptorAllocator; }
+        Ref<VulkanPipelineCache> getPipelineCache() { return m_PipelineCache; }
+
     public:
         Ref<VulkanPhysicalDevice> getPhysicalDevice() { return m_PhysicalDevice; }
         const Ref<VulkanPhysicalDevice> getPhysicalDevice() const { return m_PhysicalDevice; }
@@ -33,11 +43,49 @@ namespace Astranox
         VkQueue getGraphicsQueue() { return m_GraphicsQueue; }
         const VkQueue getGraphicsQueue() const { return m_GraphicsQueue; }
 
+        // [NOTE] When the families alias, these are the very same queue as the graphics one.
+        VkQueue getComputeQueue() { return m_ComputeQueue; }
+        const VkQueue getComputeQueue() const { return m_ComputeQueue; }
+        VkQueue getTransferQueue() { return m_TransferQueue; }
+        const VkQueue getTransferQueue() const { return m_TransferQueue; }
+
+        /**
+         * @brief Whether transfers run on a queue family of their own, e.g. a DMA engine.
+         */
+        bool hasDedicatedTransferQueue() const;
+
+        /**
+         * @brief The distinct families behind the graphics, compute and transfer queues,
+         * e.g. for resources created with VK_SHARING_MODE_CONCURRENT.
+         */
+        std::vector<uint32_t> getUniqueQueueFamilies() const;
+
+    public: // Frame timeline
+        /**
+         * Timeline semaphore signaled by the graphics submission of every frame, with increasing values.
+         * Work on other queues waits on getSubmittedFrameValue() to run after every frame submitted so far,
+         * e.g. before overwriting resources those frames read.
+         */
+        VkSemaphore getFrameTimeline() const { return m_FrameTimeline; }
+        uint64_t getSubmittedFrameValue() const { return m_SubmittedFrameValue; }
+
+        /**
+         * @brief Publish the value a frame submission signals, once it has been submitted. Render thread only.
+         */
+        void setSubmittedFrameValue(uint64_t value) { m_SubmittedFrameValue = value; }
+
     private:
         VkDevice m_Device = VK_NULL_HANDLE;
         Ref<VulkanPhysicalDevice> m_PhysicalDevice = nullptr;
 
         VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
+        VkQueue m_ComputeQueue = VK_NULL_HANDLE;
+        VkQueue m_TransferQueue = VK_NULL_HANDLE;
         Ref<VulkanCommandPool> m_CommandPool = nullptr;
+        Ref<VulkanDescriptorAllocator> m_DescriptorAllocator = nullptr;
+        Ref<VulkanPipelineCache> m_PipelineCache = nullptr;
+
+        VkSemaphore m_FrameTimeline = VK_NULL_HANDLE;
+        std::atomic<uint64_t> m_SubmittedFrameValue = 0;  // Read by uploads flushed from other threads
     };
 }
@@ -1,13 +1,44 @@
 #pragma once
+#include "Astranox/core/RefCounted.hpp"
 
 #include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+#include "VulkanUploadManager.hpp"
 
 namespace Astranox
 {
-    class VulkanImage2D
+    /**
+     * Storage image that compute shaders write and any shader can sample, e.g. the target of a post-processing pass.
+     * It stays in VK_IMAGE_LAYOUT_GENERAL for its whole lifetime.
+     */
+    class VulkanImage2D: public RefCounted
     {
     public:
-        VulkanImage2D() = default;
-        ~VulkanImage2D() = default;
+        VulkanImage2D(uint32_t width, uint32_t height, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);
+        virtual ~VulkanImage2D();
+
+    public:
+        uint32_t getWidth() const { return m_Width; }
+        uint32_t getHeight() const { return m_Height; }
+        VkFormat getFormat() const { return m_Format; }
+
+        VkImage getImage() { return m_Image; }
+        VkImageView getImageView() { return m_ImageView; }
+        VkSampler getSampler() { return m_Sampler; }
+
+        const VkDescriptorImageInfo& getDescriptorImageInfo() const { return m_DescriptorImageInfo; }
+
+    private:
+        uint32_t m_Width;
+        uint32_t m_Height;
+        VkFormat m_Format;
+
+        VkImage m_Image = VK_NULL_HANDLE;
+        VmaAllocation m_ImageAllocation = VK_NULL_HANDLE;
+        VkImageView m_ImageView = VK_NULL_HANDLE;
+        VkSampler m_Sampler = VK_NULL_HANDLE;
+
+        VkDescriptorImageInfo m_DescriptorImageInfo{};
+        UploadHandle m_UploadHandle;  // Of the initial layout transition
     };
 }
@@ -2,6 +2,7 @@
 
 #include "Astranox/rendering/IndexBuffer.hpp"
 #include "VulkanDevice.hpp"
+#include "VulkanUploadManager.hpp"
 #include "vk_mem_alloc.h"
 
 namespace Astranox
@@ -13,6 +14,7 @@ namespace Astranox
         virtual ~VulkanIndexBuffer();
 
         VkBuffer getRaw() { return m_IndexBuffer; }
+        UploadHandle getUploadHandle() const { return m_UploadHandle; }
 
         virtual uint32_t getCount() const override { return m_Count; }
 
@@ -23,5 +25,7 @@ namespace Astranox
 
         VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
         VmaAllocation m_IndexBufferAllocation = VK_NULL_HANDLE;
+
+        UploadHandle m_UploadHandle;
     };
 }
@@ -42,28 +42,13 @@ namespace Astranox
             ::vmaUnmapMemory(s_allocator, allocation);
         }
 
-    public:
-        void copyBuffer(
-            VkBuffer srcBuffer,
-            VkBuffer dstBuffer,
-            VkDeviceSize bytes
-        );
-
-        void copyBufferToImage(
-            VkBuffer buffer,
-            VkImage image,
-            uint32_t width,
-            uint32_t height
-        );
-
-    public:
-        void transitionImageLayout(
-            VkImage image,
-            VkFormat format,
-            VkImageLayout oldLayout,
-            VkImageLayout newLayout,
-            uint32_t mipLevels
-        );
+        /**
+         * Make host writes visible to the device. A no-op on host-coherent memory.
+         */
+        void flushMemory(VmaAllocation allocation, VkDeviceSize offset, VkDeviceSize bytes)
+        {
+            VK_CHECK(::vmaFlushAllocation(s_allocator, allocation, offset, bytes));
+        }
 
     private:
         std::string m_debugName;
@@ -34,6 +34,8 @@ namespace Astranox
 
         const QueueFamilyIndices& getQueueIndices() const { return m_QueueFamilyIndices; }
         const VkPhysicalDeviceFeatures& getFeatures() const { return m_Features; }
+        const VkPhysicalDeviceVulkan12Features& getVulkan12Features() const { return m_Vulkan12Features; }
+        const VkPhysicalDeviceDescriptorIndexingProperties& getDescriptorIndexingProperties() const { return m_DescriptorIndexingProperties; }
         const std::vector<VkQueueFamilyProperties>& getQueueFamilyProperties() const { return m_QueueFamilyProperties; }
         const VkPhysicalDeviceProperties& getProperties() const { return m_Properties; }
         const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const { return m_MemoryProperties; }
@@ -49,6 +51,8 @@ namespace Astranox
 
         VkPhysicalDeviceProperties m_Properties;
         VkPhysicalDeviceFeatures m_Features;
+        VkPhysicalDeviceVulkan12Features m_Vulkan12Features{};  // Supported, not enabled
+        VkPhysicalDeviceDescriptorIndexingProperties m_DescriptorIndexingProperties{};
         VkPhysicalDeviceMemoryProperties m_MemoryProperties;
 
         std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties;
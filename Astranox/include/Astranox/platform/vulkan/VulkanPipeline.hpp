@@ -4,14 +4,68 @@
 #include "Astranox/rendering/VertexBufferLayout.hpp"
 #include "VulkanShader.hpp"
 
+#include <future>
+
 namespace Astranox
 {
+    enum class BlendMode: uint8_t
+    {
+        None,
+        Alpha,     // src * a + dst * (1 - a)
+        Additive,  // src * a + dst
+    };
+
+    enum class CullMode: uint8_t
+    {
+        None,
+        Front,
+        Back,
+    };
+
+    enum class PrimitiveTopology: uint8_t
+    {
+        TriangleList,
+        TriangleStrip,
+        LineList,
+        PointList,
+    };
+
+    /**
+     * Fixed-function state that can change without touching the shader or the vertex layouts.
+     */
+    struct PipelineVariant
+    {
+        BlendMode blendMode = BlendMode::Alpha;
+        CullMode cullMode = CullMode::Back;
+        PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+
+        bool operator==(const PipelineVariant& other) const = default;
+    };
+
     struct PipelineSpecification
     {
         Ref<Shader> shader;
         VertexBufferLayout vertexBufferLayout;
+        VertexBufferLayout instanceBufferLayout;  // Advanced once per instance; may be empty
         bool depthTestEnable = true;
         bool depthWriteEnable = false;
+        PipelineVariant variant;
+
+        // Values of the shader's `layout(constant_id = N)` constants, by name. Booleans are 0 or 1, floats are bit-cast.
+        // Constants left out keep the default value declared in the shader.
+        std::map<std::string, uint32_t> specializationConstants;
+
+        // Render target. Left unset, the swapchain's render pass and formats are filled in when the pipeline is requested.
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+        /**
+         * @brief Hash of everything that ends up in the VkPipeline: shader identity, vertex input, depth state, variant,
+         * specialization constants, and the render pass with its formats. Element names are left out, since they do not affect the pipeline.
+         */
+        size_t hash() const;
+        bool operator==(const PipelineSpecification& other) const;
     };
 
     class VulkanPipeline: public RefCounted
@@ -24,14 +78,107 @@ namespace Astranox
         VkPipeline getRaw() { return m_Pipeline; }
         VkPipelineLayout getLayout() { return m_PipelineLayout; }
 
+        const PipelineSpecification& getSpecification() const { return m_Specification; }
+
+        bool usesBindlessTextures() const { return m_Specification.shader.as<VulkanShader>()->usesBindlessTextures(); }
+
+        /**
+         * @brief Recreate the pipeline from the current state of its shader (e.g. after a hot reload).
+         * The previous handles are retired through the deletion queue, since frames in flight may still use them.
+         */
+        void invalidate();
+
     private:
         void init();
+        void release();
 
     private:
         PipelineSpecification m_Specification;
 
         VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
         VkPipeline m_Pipeline = VK_NULL_HANDLE;
-        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+    };
+
+    /**
+     * A pipeline that may still be compiling on a worker thread (see PipelineLibrary::getAsync).
+     */
+    class PipelineHandle final: public RefCounted
+    {
+    public:
+        PipelineHandle(std::shared_future<Ref<VulkanPipeline>> future)
+            : m_Future(std::move(future)) {}
+        ~PipelineHandle() = default;
+
+        bool isReady() const { return m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+        /**
+         * @brief The compiled pipeline, or `fallback` while it is not ready yet. Never blocks.
+         */
+        Ref<VulkanPipeline> get(const Ref<VulkanPipeline>& fallback = nullptr) const { return isReady() ? m_Future.get() : fallback; }
+
+        /**
+         * @brief Block until the pipeline has been compiled.
+         */
+        Ref<VulkanPipeline> wait() const { return m_Future.get(); }
+
+    private:
+        std::shared_future<Ref<VulkanPipeline>> m_Future;
+    };
+
+    /**
+     * Shares pipelines between identical specifications, so each combination of shader and state is only compiled once.
+     * Pipelines are kept alive by the library until clear() is called.
+     */
+    class PipelineLibrary
+    {
+    public:
+        /**
+         * @brief Get the pipeline of `specification`, compiling it on the calling thread if needed.
+         * If it is already being compiled in the background, this waits for it instead.
+         */
+        Ref<VulkanPipeline> get(const PipelineSpecification& specification);
+
+        /**
+         * @brief Get the pipeline of `specification` without blocking. Compilation runs on the renderer's thread pool,
+         * and all workers share the device pipeline cache.
+         */
+        Ref<PipelineHandle> getAsync(const PipelineSpecification& specification);
+
+        /**
+         * @brief The pipeline of `base` with different fixed-function state. The shader and the vertex layouts are reused as-is.
+         */
+        Ref<VulkanPipeline> getVariant(const Ref<VulkanPipeline>& base, const PipelineVariant& variant);
+
+        /**
+         * @brief Block until every pipeline of `shader` that is still being compiled has been published.
+         * Pipelines of other shaders, and unrelated jobs on the thread pool, are not waited for.
+         */
+        void waitPending(const Ref<Shader>& shader);
+
+        /**
+         * @brief Recreate every pipeline built from `shader`. Pipelines keep their identity, so references to them stay valid.
+         * @return The number of pipelines recreated.
+         */
+        uint32_t invalidate(const Ref<Shader>& shader);
+
+        void clear();
+
+        size_t getSize() const;
+
+    private:
+        /**
+         * @brief Move a finished pipeline from the pending ones to the library.
+         */
+        void publish(const PipelineSpecification& specification, const Ref<VulkanPipeline>& pipeline);
+
+    private:
+        struct SpecificationHasher
+        {
+            size_t operator()(const PipelineSpecification& specification) const { return specification.hash(); }
+        };
+
+        std::unordered_map<PipelineSpecification, Ref<VulkanPipeline>, SpecificationHasher> m_Pipelines;
+        std::unordered_map<PipelineSpecification, Ref<PipelineHandle>, SpecificationHasher> m_PendingPipelines;
+        mutable std::mutex m_Mutex;
     };
 }
@@ -0,0 +1,63 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace Astranox
+{
+    /**
+     * Device-level VkPipelineCache shared by every pipeline.
+     *
+     * The cache is loaded from disk on creation and written back on destruction (or whenever save() is called).
+     * Data written by another device or driver is discarded, so a warm run only ever reuses what this driver produced.
+     * Pipelines created through it report whether the driver found them in the cache (VK_EXT_pipeline_creation_feedback, core in 1.3).
+     */
+    class VulkanPipelineCache final: public RefCounted
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t pipelineCount = 0;
+            uint32_t hitCount = 0;
+            uint32_t missCount = 0;     // Pipelines whose feedback is not valid count as neither
+            double creationMilliseconds = 0.0;
+
+            float getHitRate() const { return (hitCount + missCount) ? (float)hitCount / (hitCount + missCount) : 0.0f; }
+        };
+
+    public:
+        VulkanPipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& filepath);
+        ~VulkanPipelineCache() = default;
+
+        /**
+         * @brief Save the cache and destroy it.
+         */
+        void destroy();
+
+    public:
+        VkPipeline createGraphicsPipeline(const VkGraphicsPipelineCreateInfo& createInfo);
+        VkPipeline createComputePipeline(const VkComputePipelineCreateInfo& createInfo);
+
+        /**
+         * @brief Write the current contents of the cache to disk.
+         */
+        void save();
+
+        VkPipelineCache getRaw() { return m_PipelineCache; }
+        Statistics getStats() const;
+
+    private:
+        std::vector<uint8_t> loadInitialData();
+        void recordFeedback(const VkPipelineCreationFeedback& feedback);
+
+    private:
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkPhysicalDeviceProperties m_Properties{};
+        std::filesystem::path m_Filepath;
+
+        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
+        Statistics m_Stats;
+        mutable std::mutex m_StatsMutex;
+    };
+}
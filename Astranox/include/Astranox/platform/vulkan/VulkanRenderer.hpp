@@ -37,5 +37,29 @@ namespace Astranox
             Ref<VertexBuffer> vertexBuffer,
             Ref<IndexBuffer> indexBuffer,
             uint32_t indexCount = 1) override;
+
+        void renderInstanced(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            Ref<VertexBuffer> vertexBuffer,
+            Ref<VertexBuffer> instanceBuffer,
+            Ref<IndexBuffer> indexBuffer,
+            uint32_t indexCount,
+            uint32_t instanceCount) override;
+
+        void pushConstants(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            const void* data,
+            uint32_t size,
+            uint32_t offset = 0) override;
+
+        void dispatchCompute(
+            Ref<VulkanComputePipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            uint32_t groupCountX,
+            uint32_t groupCountY = 1,
+            uint32_t groupCountZ = 1) override;
 	};
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "Astranox/rendering/Shader.hpp"
-#include "VulkanShaderCompiler.hpp"
 
 #include <vulkan/vulkan.h>
 
@@ -12,6 +11,8 @@ namespace Astranox
         uint32_t count;
         VkShaderStageFlags shaderStage;
         std::string name;
+
+        bool operator==(const UniformBufferInfo& other) const = default;
     };
 
     struct ImageSamplerInfo
@@ -19,16 +20,85 @@ namespace Astranox
         uint32_t arraySize;
         VkShaderStageFlags shaderStage;
         std::string name;
+
+        bool operator==(const ImageSamplerInfo& other) const = default;
+    };
+
+    struct StorageBufferInfo
+    {
+        VkShaderStageFlags shaderStage;
+        std::string name;
+
+        bool operator==(const StorageBufferInfo& other) const = default;
+    };
+
+    struct StorageImageInfo
+    {
+        uint32_t arraySize;
+        VkShaderStageFlags shaderStage;
+        std::string name;
+
+        bool operator==(const StorageImageInfo& other) const = default;
+    };
+
+    struct PushConstantInfo
+    {
+        uint32_t offset;
+        uint32_t size;
+        VkShaderStageFlags shaderStage;
+        std::string name;
+
+        bool operator==(const PushConstantInfo& other) const = default;
+    };
+
+    struct VertexInputInfo
+    {
+        uint32_t location;
+        VkFormat format;
+        std::string name;
+
+        bool operator==(const VertexInputInfo& other) const = default;
+    };
+
+    /**
+     * A `layout(constant_id = N) const` declaration, whose value is chosen when a pipeline is created.
+     */
+    struct SpecializationConstantInfo
+    {
+        uint32_t constantID;
+        VkShaderStageFlags shaderStage;
+        std::string name;
+
+        bool operator==(const SpecializationConstantInfo& other) const = default;
     };
 
+    /**
+     * Resources of one descriptor set.
+     */
     struct ShaderDescriptorSetInfo
     {
         std::map<uint32_t, UniformBufferInfo> uniformBufferInfos;  // [binding, info]
         std::map<uint32_t, ImageSamplerInfo> imageSamplerInfos;    // [binding, info]
+        std::map<uint32_t, StorageBufferInfo> storageBufferInfos;  // [binding, info]
+        std::map<uint32_t, StorageImageInfo> storageImageInfos;    // [binding, info]
 
         std::map<std::string, VkWriteDescriptorSet> writeDescriptorSets;  // [name, wd]
     };
 
+    /**
+     * Interface of a shader as found by SPIR-V reflection, merged across its stages.
+     */
+    struct ShaderReflectionData
+    {
+        std::vector<ShaderDescriptorSetInfo> descriptorSets;  // Indexed by set, unused sets are empty
+        std::vector<PushConstantInfo> pushConstants;          // One per block
+        std::vector<VertexInputInfo> vertexInputs;            // Sorted by location
+        std::vector<SpecializationConstantInfo> specializationConstants;  // Sorted by constant ID
+
+        // Whether the shader samples `u_Textures[]` of the bindless texture table (set 1)
+        bool usesBindlessTextures = false;
+    };
+
     class VulkanShader : public Shader
     {
     public:
@@ -36,6 +106,15 @@ namespace Astranox
         virtual ~VulkanShader();
 
         void createDescriptorSetLayouts();
+        void createPushConstantRanges();
+
+        /**
+         * @brief Take over the shader modules of `recompiled`, a new build of the same source.
+         * Descriptor set layouts and push constant ranges are kept, so existing descriptor sets stay valid.
+         * The old modules are retired through the deletion queue when `recompiled` is destroyed.
+         * @return Whether the modules were swapped. They are not if the interface of the shader changed.
+         */
+        bool reload(Ref<VulkanShader> recompiled);
 
     public:
         void bind() override;
@@ -43,17 +122,40 @@ namespace Astranox
 
     public:
         const std::string& getName() const override { return m_Name; }
+        const std::filesystem::path& getFilepath() const { return m_Filepath; }
+
+        bool isCompute() const { return m_ShaderStages.size() == 1 && m_ShaderStages[0].stage == VK_SHADER_STAGE_COMPUTE_BIT; }
 
+        /**
+         * @brief Layouts of every set up to the highest one the shader uses.
+         * The slot of the bindless texture table holds the layout of the engine-wide table, which the shader does not own.
+         */
         VkDescriptorSetLayout getDescriptorSetLayout(uint32_t setIndex) { return m_DescriptorSetLayouts[setIndex]; }
         const std::vector<VkDescriptorSetLayout>& getDescriptorSetLayouts() { return m_DescriptorSetLayouts; }
 
+        // Descriptors one set of the layout `setIndex` needs, by type
+        const std::vector<VkDescriptorPoolSize>& getDescriptorPoolSizes(uint32_t setIndex) { return m_DescriptorPoolSizes[setIndex]; }
+
         const std::vector<VkPushConstantRange>& getPushConstantRanges() { return m_PushConstantRanges; }
 
         std::vector<VkPipelineShaderStageCreateInfo>& getShaderStageCreateInfos() { return m_ShaderStages; }
 
-        // TEMP
-        void setDescriptorSetInfo(const ShaderDescriptorSetInfo& info) { m_ShaderDescriptorSetInfo = info; }
-        ShaderDescriptorSetInfo& getDescriptorSetInfo() { return m_ShaderDescriptorSetInfo; }
+        const ShaderReflectionData& getReflectionData() const { return m_ReflectionData; }
+        const std::vector<ShaderDescriptorSetInfo>& getDescriptorSetInfos() const { return m_ReflectionData.descriptorSets; }
+        const std::vector<VertexInputInfo>& getVertexInputs() const { return m_ReflectionData.vertexInputs; }
+
+        const std::vector<std::string>& getKeywords() const { return m_Keywords; }
+
+        // Files pulled in through `#include`, directly or not
+        const std::vector<std::filesystem::path>& getDependencies() const { return m_Dependencies; }
+
+        /**
+         * @return The specialization constant called `name`, or nullptr if the shader does not declare it.
+         */
+        const SpecializationConstantInfo* findSpecializationConstant(const std::string& name) const;
+
+        bool usesBindlessTextures() const { return m_ReflectionData.usesBindlessTextures; }
+        bool isBindlessTextureSet(uint32_t setIndex) const;
 
     private:
         void destroy();
@@ -64,11 +166,15 @@ namespace Astranox
         std::string m_Name;
         std::filesystem::path m_Filepath;
 
-        ShaderDescriptorSetInfo m_ShaderDescriptorSetInfo;
+        std::vector<std::string> m_Keywords;  // Declared by `#keywords`, see ShaderLibrary::getVariant
+        std::vector<std::filesystem::path> m_Dependencies;
+
+        ShaderReflectionData m_ReflectionData;
 
         std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
+        std::vector<std::vector<VkDescriptorPoolSize>> m_DescriptorPoolSizes;
 
-        std::vector<VkPushConstantRange> m_PushConstantRanges;  // Unset
+        std::vector<VkPushConstantRange> m_PushConstantRanges;
 
         std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStages;
 
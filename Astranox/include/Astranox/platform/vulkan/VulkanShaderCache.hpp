@@ -0,0 +1,79 @@
+#pragma once
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+namespace Astranox
+{
+    /**
+     * On-disk cache of SPIR-V binaries, addressed by a hash of everything that affects compilation.
+     *
+     * Each binary is stored as `<hash>.spv`, so an edited source, a different set of defines or a new compiler
+     * simply misses instead of reusing stale code. A small index file maps every shader stage (and variant) to the hash
+     * it was last compiled with, which is how binaries that nothing refers to anymore are found and evicted.
+     *
+     * The index also records the files each stage included. Their contents are part of the hash, so editing a shared
+     * header invalidates the binaries of every stage that depends on it.
+     */
+    class VulkanShaderCache final
+    {
+    public:
+        VulkanShaderCache(const std::filesystem::path& directory);
+        ~VulkanShaderCache() = default;
+
+    public:
+        /**
+         * @brief Read the binary of `hash` into `spirv` and, if it is valid, record it as the current binary of `key`.
+         * Both happen under one lock, so a concurrent update of another entry cannot evict the binary in between.
+         * @return Whether a valid binary was found.
+         */
+        bool load(const std::string& key, uint64_t hash, const std::vector<std::string>& dependencies, std::vector<uint32_t>& spirv);
+
+        /**
+         * @brief Write the binary of `hash` and record it as the current binary of `key`, built from `dependencies`.
+         * The binary `key` previously pointed to is evicted, unless another entry still refers to it.
+         */
+        void store(const std::string& key, uint64_t hash, const std::vector<uint32_t>& spirv, const std::vector<std::string>& dependencies);
+
+        /**
+         * @brief Files included by the last recorded build of `key`, in the order they were first included.
+         */
+        std::vector<std::string> getDependencies(const std::string& key);
+
+        /**
+         * @brief 64-bit FNV-1a, chained through `seed`.
+         */
+        static uint64_t hash(const void* data, size_t size, uint64_t seed = s_HashSeed);
+        static uint64_t hash(std::string_view string, uint64_t seed = s_HashSeed) { return hash(string.data(), string.size(), seed); }
+
+    private:
+        std::filesystem::path getBinaryFilepath(uint64_t hash) const;
+        bool readBinaryLocked(uint64_t hash, std::vector<uint32_t>& spirv);
+        void updateEntryLocked(const std::string& key, uint64_t hash, const std::vector<std::string>& dependencies);
+
+        void loadIndex();
+        void saveIndex();
+
+        /**
+         * @brief Remove every binary in the cache directory that the index does not refer to.
+         */
+        void evictUnreferenced();
+
+    private:
+        // Bump whenever the cache layout or the hashed inputs change.
+        static constexpr uint32_t s_FormatVersion = 2;
+        static constexpr uint64_t s_HashSeed = 0xcbf29ce484222325ull;
+
+        std::filesystem::path m_Directory;
+        std::filesystem::path m_IndexFilepath;
+
+        struct Entry
+        {
+            uint64_t hash;                          // Of the current binary
+            std::vector<std::string> dependencies;  // Included files
+        };
+        std::unordered_map<std::string, Entry> m_Entries;  // [stage key, entry]
+
+        std::mutex m_Mutex;
+    };
+}
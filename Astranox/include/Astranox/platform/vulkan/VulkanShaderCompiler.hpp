@@ -1,33 +1,71 @@
 #pragma once
+#include <atomic>
 #include <filesystem>
 #include <vulkan/vulkan.h>
 
+#include "VulkanShader.hpp"
+
 namespace Astranox
 {
-    class VulkanShader;
+    // Macro name -> value. Ordered, so the same set of defines always hashes to the same cache key.
+    using ShaderDefines = std::map<std::string, std::string>;
 
     class VulkanShaderCompiler: public RefCounted
     {
     public:
-        VulkanShaderCompiler(const std::filesystem::path& shaderFilepath);
+        VulkanShaderCompiler(const std::filesystem::path& shaderFilepath, const ShaderDefines& defines = {});
         virtual ~VulkanShaderCompiler() = default;
 
-        static Ref<VulkanShader> compile(const std::filesystem::path& shaderFilepath);
+        static Ref<VulkanShader> compile(const std::filesystem::path& shaderFilepath, const ShaderDefines& defines = {});
 
-        const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& getShaderData() { return m_ShaderData; }
+        /**
+         * @brief Compile several shaders at once. The stages of all of them are compiled (or loaded from the cache)
+         * and reflected in parallel on the renderer's thread pool.
+         * @return The shaders, in the order of `shaderFilepaths`. Shaders that failed to compile are null, and the errors are logged.
+         */
+        static std::vector<Ref<VulkanShader>> compileBatch(const std::vector<std::filesystem::path>& shaderFilepaths, const ShaderDefines& defines = {});
 
     private:
-        void process();
+        /**
+         * @brief Read and split the source, and hash the options. Runs on the calling thread.
+         */
+        void preprocess();
+
+        /**
+         * @brief Get the binary of one stage from the cache or compile it, resolving its `#include`s, then reflect it.
+         * Jobs of different stages of the same compiler may run concurrently.
+         */
+        void compileStage(VkShaderStageFlagBits stage);
+
+        Ref<VulkanShader> createShader();
 
         std::string readFile(const std::filesystem::path& filepath);
         std::map<VkShaderStageFlagBits, std::string> parseShader(const std::string& srcCode);
-        void compileOrGetVulkanBinaries(const std::map<VkShaderStageFlagBits, std::string>& shaderSources);
 
-        void reflect(VkShaderStageFlagBits stage, const std::vector<uint32_t>& spirv);
+        /**
+         * @brief Collect the resources, push constants, specialization constants and (for the vertex stage) inputs of one stage.
+         */
+        void reflect(VkShaderStageFlagBits stage, const std::vector<uint32_t>& spirv, ShaderReflectionData& reflectionData);
 
     private:
+        static constexpr bool s_Optimize = true;
+        // [NOTE] Resources and specialization constants are looked up by name, and the optimizer strips names without debug info.
+        static constexpr bool s_GenerateDebugInfo = true;
+
         std::filesystem::path m_ShaderFilepath;
+        ShaderDefines m_Defines;
 
+        uint64_t m_OptionsHash = 0;
+        uint64_t m_DefinesHash = 0;
+
+        std::vector<std::string> m_Keywords;
+        std::map<VkShaderStageFlagBits, std::string> m_ShaderSources;
         std::map<VkShaderStageFlagBits, std::vector<uint32_t>> m_ShaderData;
+        std::map<VkShaderStageFlagBits, std::vector<std::string>> m_StageDependencies;  // Files included by each stage
+        std::map<VkShaderStageFlagBits, ShaderReflectionData> m_StageReflectionData;
+
+        ShaderReflectionData m_ReflectionData;  // Merged across stages
+
+        std::atomic<bool> m_Failed = false;  // Set by any stage job
     };
 }
@@ -0,0 +1,35 @@
+#pragma once
+#include "Astranox/rendering/StorageBuffer.hpp"
+#include "Astranox/platform/vulkan/VulkanDevice.hpp"
+#include "VulkanUploadManager.hpp"
+#include "vk_mem_alloc.h"
+
+namespace Astranox
+{
+    class VulkanStorageBuffer: public StorageBuffer
+    {
+    public:
+        VulkanStorageBuffer(uint32_t bytes);
+        virtual ~VulkanStorageBuffer();
+
+        virtual void setData(const void* data, uint32_t bytes, uint32_t offset = 0) override;
+
+        virtual uint32_t getSize() const override { return m_Bytes; }
+
+        VkBuffer getRaw() { return m_StorageBuffer; }
+        const VkDescriptorBufferInfo& getDescriptorBufferInfo() const { return m_DescriptorBufferInfo; }
+
+    private:
+        Ref<VulkanDevice> m_Device = nullptr;
+
+        uint32_t m_Bytes = 0;
+
+        VkBuffer m_StorageBuffer = VK_NULL_HANDLE;
+        VmaAllocation m_StorageBufferAllocation = VK_NULL_HANDLE;
+        VkSharingMode m_SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkDescriptorBufferInfo m_DescriptorBufferInfo{};
+
+        UploadHandle m_UploadHandle;  // Of the latest setData()
+    };
+}
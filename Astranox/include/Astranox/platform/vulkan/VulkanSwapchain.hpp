@@ -1,5 +1,6 @@
 #pragma once
 #include "Astranox/core/RefCounted.hpp"
+#include "Astranox/core/Window.hpp"
 
 #include "VulkanDevice.hpp"
 #include "VulkanCommandBuffer.hpp"
@@ -21,40 +22,85 @@ namespace Astranox
     class VulkanSwapchain: public RefCounted
     {
     public:
-        VulkanSwapchain(Ref<VulkanDevice> device);
+        /**
+         * @param headless Render into engine-owned offscreen images instead of surface images.
+         *                 No surface is created and nothing is presented.
+         */
+        VulkanSwapchain(Ref<VulkanDevice> device, bool headless = false);
         virtual ~VulkanSwapchain() = default;
 
         void createSurface();
-        void createSwapchain(uint32_t width, uint32_t height);
+        /**
+         * @return False if the swapchain could not be (re)created, e.g. while the window has a zero extent.
+         */
+        bool createSwapchain(uint32_t width, uint32_t height);
 
         void destroy();
 
     public:
-        void resize(uint32_t width, uint32_t height);
-
-        void beginFrame();
+        bool resize(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Wait for the frame slot and acquire the next image.
+         * @return False if no image could be acquired (the swapchain is out of date and cannot be recreated yet).
+         * The frame must then be skipped: nothing is recorded and present() is not called.
+         */
+        bool beginFrame();
         void present();
 
+        /**
+         * @brief Switch the present mode. The swapchain is recreated at the start of the next frame,
+         * and the old one is released through the deletion queue.
+         */
+        void setPresentPolicy(PresentPolicy policy);
+        PresentPolicy getPresentPolicy() const { return m_PresentPolicy; }
+
     public:
         uint32_t getWidth() const { return m_SwapchainExtent.width; }
         uint32_t getHeight() const { return m_SwapchainExtent.height; }
         VkExtent2D getExtent() const { return m_SwapchainExtent; }
 
         VkRenderPass getRenderPass() { return m_RenderPass; }
+        VkFormat getImageFormat() const { return m_ImageFormat; }
         uint32_t getImageCount() const { return static_cast<uint32_t>(m_Images.size()); }
+        uint32_t getCurrentImageIndex() const { return m_CurrentImageIndex; }
 
         VkFramebuffer getCurrentFramebuffer() { return m_Framebuffers[m_CurrentImageIndex]; }
         VkCommandBuffer getCurrentCommandBuffer();
 
+        /**
+         * @brief Command buffer of the current frame on the compute queue, begun on first use.
+         * It is submitted right before the frame, and the frame waits for it.
+         */
+        VkCommandBuffer getCurrentComputeCommandBuffer();
+
+        bool isHeadless() const { return m_Headless; }
+
     private:
         void chooseSurfaceFormat();
 
         void getQueueIndices();
         void getSwapchainImages();
 
+        bool createPresentImages(uint32_t width, uint32_t height);
+        bool createOffscreenImages(uint32_t width, uint32_t height);
+        /**
+         * @brief Hand the current images over to the deletion queue, since frames in flight may still render into them.
+         */
+        void retireImages();
+
+        void createDepthStencil();
         void createRenderPass();
         void createFramebuffers();
-        void createSyncObjects();
+        void createFrameContexts();
+        void createImageSyncObjects();
+        void destroyImageSyncObjects();
+
+        /**
+         * @brief Submit the compute work of the frame, if any was recorded.
+         * @return The semaphore signaled once it has finished, or VK_NULL_HANDLE.
+         */
+        VkSemaphore submitCompute(uint32_t frameIndex);
 
         VkImageView createImageView(
             VkImage image,
@@ -65,6 +111,7 @@ namespace Astranox
 
     private:
         Ref<VulkanDevice> m_Device = nullptr;
+        bool m_Headless = false;
 
         uint32_t m_GraphicsQueueIndex = 0;
         uint32_t m_PresentQueueIndex = 0;
@@ -77,24 +124,48 @@ namespace Astranox
         VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
         VkExtent2D m_SwapchainExtent{};
 
+        PresentPolicy m_PresentPolicy = PresentPolicy::LowLatency;
+        bool m_PresentPolicyChanged = false;
+
         struct SwapchainImage
         {
             VkImage image;
             VkImageView imageView;
+            VmaAllocation allocation = VK_NULL_HANDLE;  // Only offscreen images own their memory
         };
         std::vector<SwapchainImage> m_Images;
 
         VkRenderPass m_RenderPass = VK_NULL_HANDLE;
 
         std::vector<VkFramebuffer> m_Framebuffers;
-        //uint32_t m_CurrentFrameIndex = 0;
         uint32_t m_CurrentImageIndex = 0;
 
-        std::vector<VkCommandBuffer> m_CommandBuffers;
+        /**
+         * Everything a frame in flight owns, indexed by Renderer::getCurrentFrameIndex().
+         * The number of frames is RendererConfig::framesInFlight, independent of the swapchain image count.
+         * Transient descriptor sets of the frame live in the device's descriptor allocator and are reset by beginFrame().
+         */
+        struct FrameContext
+        {
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
+            VkFence inFlightFence = VK_NULL_HANDLE;
+
+            // [NOTE] Compute work is covered by the in-flight fence too, since the graphics submission waits on it.
+            VkCommandBuffer computeCommandBuffer = VK_NULL_HANDLE;
+            VkSemaphore computeFinishedSemaphore = VK_NULL_HANDLE;
+            bool computeRecording = false;  // Whether the compute command buffer has been begun
+        };
+        std::vector<FrameContext> m_Frames;
+
+        VkCommandPool m_ComputeCommandPool = VK_NULL_HANDLE;
 
-        std::vector<VkSemaphore> m_ImageAvailableSemaphores;
+        // Per swapchain image >>>
+        // [NOTE] The presentation engine may still be reading the semaphore after the frame's fence has signaled,
+        //        so it belongs to the image rather than to the frame.
         std::vector<VkSemaphore> m_RenderFinishedSemaphores;
-        std::vector<VkFence> m_InFlightFences;
+        std::vector<VkFence> m_ImageFences;  // In-flight fence of the frame that last rendered into the image, if any
+        // <<< Per swapchain image
 
         //struct ColorAttachment
         //{
@@ -108,6 +179,7 @@ namespace Astranox
             VkImage image = VK_NULL_HANDLE;
             VmaAllocation allocation;
             VkImageView imageView = VK_NULL_HANDLE;
+            VkExtent2D extent{};  // May be larger than the swapchain extent, see createSwapchain()
         } m_DepthStencil;
     };
 }
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <vulkan/vulkan.h>
 #include "vk_mem_alloc.h"
+#include "VulkanUploadManager.hpp"
 
 namespace Astranox
 {
@@ -15,7 +16,11 @@ namespace Astranox
 
     public:
         void loadFromFile(const std::filesystem::path& path);
-        void generateMipmaps();
+        /**
+         * @brief Record the mip chain blits, leaving every level in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+         * Expects every level in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, with level 0 holding the pixels.
+         */
+        void generateMipmaps(VkCommandBuffer blitCmdBuffer);
 
     public:
         uint32_t getWidth() const override { return m_Width; }
@@ -30,13 +35,7 @@ namespace Astranox
         VkSampler getSampler() { return m_TextureSampler; }
 
         const VkDescriptorImageInfo& getDescriptorImageInfo() const { return m_DescriptorImageInfo; }
-
-    public:
-        bool operator==(const Texture2D& other) const override
-        {
-            // Temp, compare handles instead
-            return m_Path == other.getPath();
-        }
+        UploadHandle getUploadHandle() const { return m_UploadHandle; }
 
     private:
         uint32_t calculateMipLevels();
@@ -69,5 +68,6 @@ namespace Astranox
         VkSampler m_TextureSampler;
 
         VkDescriptorImageInfo m_DescriptorImageInfo{};
+        UploadHandle m_UploadHandle;
     }; 
 }
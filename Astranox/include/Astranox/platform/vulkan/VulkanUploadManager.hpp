@@ -0,0 +1,159 @@
+#pragma once
+#include "Astranox/core/RefCounted.hpp"
+
+#include "VulkanDevice.hpp"
+#include "vk_mem_alloc.h"
+
+#include <deque>
+#include <functional>
+
+namespace Astranox
+{
+    /**
+     * Identifies the batch an upload was recorded into.
+     * A default-constructed handle refers to nothing and is always complete.
+     */
+    struct UploadHandle
+    {
+        uint64_t batch = 0;
+    };
+
+    /**
+     * Streams data from the host into device-local resources without stalling the CPU.
+     *
+     * Source data is copied into a persistently mapped staging ring, and the transfer commands
+     * (copies, layout transitions, mip blits) are recorded into the current batch.
+     * A batch is submitted when the frame is presented or when flush() is called,
+     * and its staging range is reclaimed once its fence has signaled.
+     *
+     * When the device has a dedicated transfer queue, copies run there and the destination resources
+     * are handed over to the graphics family through ownership transfers and a semaphore, so uploads
+     * can overlap rendering. Otherwise, everything is recorded on the graphics queue.
+     *
+     * [NOTE] Buffers may be updated in place while submitted frames still read them, so a batch with buffer uploads
+     *      only starts copying once every frame submitted before it has completed (see VulkanDevice::getFrameTimeline).
+     *      New images have no readers yet, so batches of texture uploads keep overlapping rendering.
+     */
+    class VulkanUploadManager final: public RefCounted
+    {
+    public:
+        VulkanUploadManager(Ref<VulkanDevice> device);
+        ~VulkanUploadManager() = default;
+
+        void destroy();
+
+    public:
+        /**
+         * @brief Copy `bytes` of `data` into `dstBuffer`, starting at `dstOffset`.
+         * @param sharingMode Sharing mode `dstBuffer` was created with. Concurrent buffers need no ownership transfer.
+         */
+        UploadHandle uploadBuffer(
+            VkBuffer dstBuffer,
+            const void* data,
+            VkDeviceSize bytes,
+            VkDeviceSize dstOffset = 0,
+            VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE);
+
+        /**
+         * @brief Copy tightly packed pixels into mip 0 of a 2D color image.
+         * Every mip level is left in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+         * so the caller is expected to record() the mip blits or the final transition.
+         */
+        UploadHandle uploadImage(VkImage dstImage, const void* data, VkDeviceSize bytes, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+        /**
+         * @brief Record arbitrary commands into the current batch.
+         * They run on the graphics queue, after the batch's copies have completed and been acquired,
+         * so blits and layout transitions of freshly uploaded resources are allowed.
+         */
+        UploadHandle record(const std::function<void(VkCommandBuffer)>& commands);
+
+        /**
+         * @brief Submit the current batch, if anything has been recorded into it.
+         */
+        void flush();
+
+        bool isComplete(UploadHandle handle);
+
+        /**
+         * @brief Block until the batch of `handle` has finished executing. The batch is submitted first if necessary.
+         */
+        void wait(UploadHandle handle);
+
+        /**
+         * @brief Reclaim the staging memory and command buffers of every batch whose fence has signaled.
+         */
+        void retire();
+
+        /**
+         * Timeline semaphore that reaches the ID of a batch once the whole batch has executed.
+         * Queues other than graphics (e.g. async compute) wait on it to see the uploads.
+         */
+        VkSemaphore getTimeline() const { return m_Timeline; }
+        uint64_t getSubmittedBatchID();
+
+    private:
+        struct Batch
+        {
+            uint64_t id = 0;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;          // Graphics queue
+            VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;  // Transfer queue, same as `commandBuffer` without a dedicated one
+            VkSemaphore transferSemaphore = VK_NULL_HANDLE;          // Dedicated transfer queue only
+            VkFence fence = VK_NULL_HANDLE;
+
+            bool waitsForFrames = false;  // Overwrites buffers that submitted frames may read
+
+            VkDeviceSize ringHead = 0;  // Ring position after the last staging allocation of this batch
+            std::vector<std::pair<VkBuffer, VmaAllocation>> dedicatedStagingBuffers;  // Uploads too large for the ring
+        };
+
+        /**
+         * @brief Reserve `bytes` of staging memory for the current batch.
+         * @return The buffer to copy from and the offset of the reserved range in it.
+         */
+        std::pair<VkBuffer, VkDeviceSize> allocateStaging(const void* data, VkDeviceSize bytes);
+        bool tryAllocateFromRing(VkDeviceSize bytes, VkDeviceSize& offset);
+
+        Batch& getRecordingBatch();
+        VkCommandBuffer allocateCommandBuffer(VkCommandPool commandPool);
+        void flushLocked();
+        void retireLocked();
+        void waitOldestLocked();
+
+    private:
+        static constexpr VkDeviceSize s_StagingRingSize = 64 * 1024 * 1024;
+        static constexpr VkDeviceSize s_DedicatedStagingThreshold = s_StagingRingSize / 4;
+
+        Ref<VulkanDevice> m_Device = nullptr;
+
+        bool m_DedicatedTransfer = false;
+        uint32_t m_GraphicsFamily = 0;
+        uint32_t m_TransferFamily = 0;
+
+        VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+        VkCommandPool m_TransferCommandPool = VK_NULL_HANDLE;  // Dedicated transfer queue only
+
+        VkBuffer m_StagingBuffer = VK_NULL_HANDLE;
+        VmaAllocation m_StagingAllocation = VK_NULL_HANDLE;
+        uint8_t* m_StagingData = nullptr;  // Mapped for the lifetime of the manager
+        VkDeviceSize m_StagingAlignment = 16;
+
+        // [NOTE] The head never catches up with the tail, so head == tail always means the ring is empty.
+        VkDeviceSize m_RingHead = 0;
+        VkDeviceSize m_RingTail = 0;
+
+        Batch m_RecordingBatch;
+        bool m_Recording = false;
+
+        std::deque<Batch> m_InFlightBatches;  // In submission order
+        std::vector<Batch> m_FreeBatches;     // Command buffers and fences ready for reuse
+
+        uint64_t m_NextBatchID = 1;
+        uint64_t m_SubmittedBatchID = 0;
+        uint64_t m_CompletedBatchID = 0;
+
+        VkSemaphore m_Timeline = VK_NULL_HANDLE;
+
+        std::mutex m_Mutex;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "Astranox/rendering/VertexBuffer.hpp"
 #include "VulkanDevice.hpp"
+#include "VulkanUploadManager.hpp"
 
 #include "vk_mem_alloc.h"
 
@@ -16,12 +17,19 @@ namespace Astranox
 
         void setData(const void* data, uint32_t bytes) override;
 
+        void* getMappedData() override { return m_MappedVertexBuffer; }
+        void flush(uint32_t bytes, uint32_t offset = 0) override;
+
         VkBuffer getRaw() { return m_VertexBuffer; }
+        UploadHandle getUploadHandle() const { return m_UploadHandle; }
 
     private:
         Ref<VulkanDevice> m_Device = nullptr;
 
         VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
         VmaAllocation m_VertexBufferAllocation = VK_NULL_HANDLE;
+        void* m_MappedVertexBuffer = nullptr;  // Only dynamic buffers are mapped
+
+        UploadHandle m_UploadHandle;  // Only static buffers are uploaded
     };
 }
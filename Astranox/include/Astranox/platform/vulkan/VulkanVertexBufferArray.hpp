@@ -0,0 +1,28 @@
+#pragma once
+#include "Astranox/rendering/VertexBufferArray.hpp"
+#include "Astranox/rendering/Renderer.hpp"
+#include "VulkanContext.hpp"
+
+namespace Astranox
+{
+    class VulkanVertexBufferArray : public VertexBufferArray
+    {
+    public:
+        VulkanVertexBufferArray(uint32_t bytes);
+        virtual ~VulkanVertexBufferArray() = default;
+
+        Ref<VertexBuffer> getBuffer(uint32_t frameIndex) override
+        {
+            return m_VertexBuffers[frameIndex];
+        }
+
+        Ref<VertexBuffer> getCurrentBuffer() override
+        {
+            uint32_t currentFrameIndex = Renderer::getCurrentFrameIndex();
+            return m_VertexBuffers[currentFrameIndex];
+        }
+
+    private:
+        std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+    };
+}
@@ -20,13 +20,13 @@ namespace Astranox
     public:
         void onResize(uint32_t width, uint32_t height) override;
 
-        void beginFrame() override;
+        bool beginFrame() override;
 
         void pollEvents() override;
         void swapBuffers() override;
 
-        void setVSync(bool enable) override;
-        bool isVSync() const override { return m_Data.vsync; }
+        void setPresentPolicy(PresentPolicy policy) override;
+        PresentPolicy getPresentPolicy() const override { return m_Data.presentPolicy; }
 
         void setEventCallback(const EventCallbackFn& callback) override { m_Data.eventCallback = callback; }
 
@@ -57,7 +57,7 @@ namespace Astranox
             uint32_t width;
             uint32_t height;
 
-            bool vsync;
+            PresentPolicy presentPolicy;
             EventCallbackFn eventCallback;
         };
         WindowData m_Data;
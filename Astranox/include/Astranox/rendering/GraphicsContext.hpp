@@ -6,7 +6,10 @@ namespace Astranox
     class GraphicsContext: public RefCounted
     {
     public:
-        static Ref<GraphicsContext> create();
+        /**
+         * @param headless Render into offscreen images instead of a window surface.
+         */
+        static Ref<GraphicsContext> create(bool headless = false);
         virtual ~GraphicsContext() = default;
 
         virtual void init(uint32_t& width, uint32_t& height) = 0;
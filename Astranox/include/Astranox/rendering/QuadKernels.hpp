@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Astranox
+{
+    /**
+     * Quad transforms in structure-of-arrays form, so that several quads can be processed per SIMD register.
+     */
+    struct QuadStreams
+    {
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<float> halfWidth;
+        std::vector<float> halfHeight;
+        std::vector<float> sin;
+        std::vector<float> cos;
+
+        void resize(size_t count);
+        size_t size() const { return positionX.size(); }
+    };
+
+    namespace QuadKernels
+    {
+        /**
+         * @brief Compute the 4 corners of each quad in [first, first + count).
+         * Corners are produced in the order of the quad index buffer: bottom-left, bottom-right, top-right, top-left.
+         * Corner `j` of the `i`-th quad is written as 3 floats to `(uint8_t*)dst + (4 * i + j) * stride`.
+         *
+         * Uses the widest SIMD path the translation unit is compiled for (AVX, SSE2), or the scalar fallback.
+         */
+        void computeCorners(const QuadStreams& quads, size_t first, size_t count, void* dst, size_t stride);
+
+        /** @brief Reference implementation of computeCorners(). */
+        void computeCornersScalar(const QuadStreams& quads, size_t first, size_t count, void* dst, size_t stride);
+    }
+}
@@ -2,7 +2,9 @@
 #include "RendererAPI.hpp"
 
 #include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/rendering/Shader.hpp"
 #include "Astranox/rendering/Texture2D.hpp"
+#include "Astranox/core/ThreadPool.hpp"
 
 namespace Astranox
 {
@@ -14,7 +16,10 @@ namespace Astranox
 
     struct RendererConfig
     {
-        uint32_t framesInFlight;
+        uint32_t framesInFlight = 2;
+
+        // Recompile shaders of the renderer's shader library when their source changes (see ShaderLibrary)
+        bool shaderHotReload = false;
     };
 
     class Renderer
@@ -27,6 +32,10 @@ namespace Astranox
         static uint32_t getCurrentFrameIndex();
 
         static const RendererConfig& getConfig();
+        /**
+         * @brief Must be called before the graphics context is created, since the swapchain sizes its frame contexts from it.
+         */
+        static void setConfig(const RendererConfig& config);
 
     public:
         static void beginFrame();
@@ -48,15 +57,59 @@ namespace Astranox
             Ref<IndexBuffer> indexBuffer,
             uint32_t indexCount);
 
+        static void renderInstanced(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            Ref<VertexBuffer> vertexBuffer,
+            Ref<VertexBuffer> instanceBuffer,
+            Ref<IndexBuffer> indexBuffer,
+            uint32_t indexCount,
+            uint32_t instanceCount);
+
         static void renderMesh(
             VkCommandBuffer commandBuffer,
             Ref<VulkanPipeline> pipeline,
             Mesh& mesh,
             uint32_t instanceCount);
 
+        static void pushConstants(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            const void* data,
+            uint32_t size,
+            uint32_t offset = 0);
+
+        static void dispatchCompute(
+            Ref<VulkanComputePipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            uint32_t groupCountX,
+            uint32_t groupCountY = 1,
+            uint32_t groupCountZ = 1);
+
     public:
         static Ref<Texture2D> getWhiteTexture();
 
+        /**
+         * @brief Renderer-wide shader library. Hot reloads are applied at the start of each frame, and it is cleared on shutdown.
+         */
+        static ShaderLibrary& getShaderLibrary();
+
+        /**
+         * @brief Renderer-wide pipeline library. It is cleared on shutdown.
+         */
+        static PipelineLibrary& getPipelineLibrary();
+
+        /**
+         * @brief Workers for background jobs such as pipeline compilation. Available between init() and shutdown().
+         */
+        static ThreadPool& getThreadPool();
+
+        /**
+         * @brief Pool, set and per-type descriptor usage of the device's descriptor allocator, e.g. for telemetry.
+         */
+        static VulkanDescriptorAllocator::Statistics getDescriptorStats();
+
     private:
         //static VkSampleCountFlagBits getMaxUsableSampleCount();
 
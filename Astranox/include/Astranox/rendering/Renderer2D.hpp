@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <glm/glm.hpp>
 
 #include "PerspectiveCamera.hpp"
@@ -7,10 +8,29 @@
 
 namespace Astranox
 {
+    struct Renderer2DSpecification
+    {
+        // Submit each quad as a single instance record and expand the corners in the vertex shader,
+        // instead of transforming four vertices on the CPU.
+        bool instanced = false;
+
+        // Fragments less opaque than this are discarded, so that cut-out sprites can write depth. 0 disables the test.
+        // Baked into the pipeline as specialization constants, so the disabled test costs nothing.
+        float alphaCutoff = 0.0f;
+    };
+
+    struct QuadDesc
+    {
+        glm::vec3 position;
+        glm::vec2 size = { 1.0f, 1.0f };
+        float rotation = 0.0f;  // Degrees
+        glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    };
+
     class Renderer2D: public RefCounted
     {
     public:
-        void init();
+        void init(const Renderer2DSpecification& specification = {});
         void shutdown();
 
         void beginScene(const PerspectiveCamera& camera);
@@ -24,10 +44,17 @@ namespace Astranox
         void drawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float degrees, const glm::vec4& color);
         void drawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float degrees, const glm::vec4& color);
 
+        /**
+         * @brief Draw many untextured quads at once.
+         * Prefer this over calling drawQuad() in a loop: the corners are computed several quads at a time with SIMD.
+         */
+        void drawQuads(std::span<const QuadDesc> quads);
+
         struct Statistics
         {
             uint32_t drawCalls = 0;
             uint32_t quadCount = 0;
+            std::vector<uint32_t> batchQuadCounts;  // Number of quads in each batch, in submission order
 
             uint32_t getTotalVertexCount() const { return quadCount * 4; };
             uint32_t getTotalIndexCount() const { return quadCount * 6; };
@@ -2,6 +2,7 @@
 #include "Mesh.hpp"
 #include <vulkan/vulkan.h>
 #include "Astranox/platform/vulkan/VulkanPipeline.hpp"
+#include "Astranox/platform/vulkan/VulkanComputePipeline.hpp"
 #include "Astranox/platform/vulkan/VulkanDescriptorManager.hpp"
 
 namespace Astranox
@@ -39,6 +40,33 @@ namespace Astranox
             Ref<IndexBuffer> indexBuffer,
             uint32_t instanceCount = 1) = 0;
 
+        // [NOTE] `vertexBuffer` may be null when the vertices are generated in the vertex shader.
+        virtual void renderInstanced(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            Ref<VertexBuffer> vertexBuffer,
+            Ref<VertexBuffer> instanceBuffer,
+            Ref<IndexBuffer> indexBuffer,
+            uint32_t indexCount,
+            uint32_t instanceCount) = 0;
+
+        // [NOTE] The stages are taken from the push constant ranges of the pipeline's shader that overlap the written bytes.
+        virtual void pushConstants(
+            VkCommandBuffer commandBuffer,
+            Ref<VulkanPipeline> pipeline,
+            const void* data,
+            uint32_t size,
+            uint32_t offset = 0) = 0;
+
+        // [NOTE] Dispatches are recorded for the compute queue, and the current frame waits for them before rendering.
+        virtual void dispatchCompute(
+            Ref<VulkanComputePipeline> pipeline,
+            Ref<VulkanDescriptorManager> dm,
+            uint32_t groupCountX,
+            uint32_t groupCountY = 1,
+            uint32_t groupCountZ = 1) = 0;
+
     public:
         static Type getType() { return s_Type; }
 
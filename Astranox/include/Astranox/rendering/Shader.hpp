@@ -2,6 +2,9 @@
 
 #include <string>
 #include <filesystem>
+#include <future>
+
+#include "Astranox/core/FileWatcher.hpp"
 
 namespace Astranox
 {
@@ -17,17 +20,81 @@ namespace Astranox
         virtual void unbind() = 0;
     };
 
+    /**
+     * Named collection of shaders.
+     *
+     * With hot reload enabled, the sources of loaded shaders and the files they include are watched. A shader whose
+     * source or includes changed is recompiled on the renderer's thread pool, and update() swaps the new modules into
+     * the existing shader and rebuilds the pipelines of the renderer's pipeline library that use it. A source that fails
+     * to compile leaves the running version in place.
+     */
     class ShaderLibrary
     {
     public:
+        ShaderLibrary() = default;
+        ~ShaderLibrary();
+
         void add(Ref<Shader> shader);
         void add(const std::string& name, Ref<Shader> shader);
 
         Ref<Shader> load(const std::filesystem::path& filepath);
 
+        /**
+         * @brief Load several shaders at once, compiling all of their stages in parallel.
+         * @return The shaders, in the order of `filepaths`.
+         */
+        std::vector<Ref<Shader>> loadAll(const std::vector<std::filesystem::path>& filepaths);
+
         Ref<Shader> get(const std::string& name);
 
+        /**
+         * @brief Get the variant of shader `name` compiled with `keywords` defined (to 1), compiling it on first use.
+         * The keywords must be declared by a `#keywords` line of the source. Variants are cached by the library
+         * and by the shader binary cache, and are hot reloaded like the shader they derive from.
+         * Without keywords, this is the shader itself.
+         */
+        Ref<Shader> getVariant(const std::string& name, std::vector<std::string> keywords);
+
+        bool exists(const std::string& name) const { return m_Shaders.find(name) != m_Shaders.end(); }
+
+        /**
+         * @brief Drop every shader. Background recompilations are waited for first.
+         */
+        void clear();
+
+    public: // Hot reload
+        void setHotReload(bool enabled) { m_HotReload = enabled; }
+        bool isHotReloadEnabled() const { return m_HotReload; }
+
+        /**
+         * @brief Start recompiling changed sources and swap in the ones that are done. Call once per frame on the render thread.
+         */
+        void update();
+
+    private:
+        /**
+         * @brief Watch the source of shader `name` and every file it includes.
+         */
+        void watchSources(const std::string& name);
+        /**
+         * @brief Stop watching those of `filepaths` that no shader in the library reads anymore.
+         */
+        void unwatchUnused(const std::vector<std::filesystem::path>& filepaths);
+        void requestReload(const std::string& name);
+
     private:
         std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+        std::unordered_map<std::string, std::filesystem::path> m_Filepaths;  // [name, source], shaders loaded from a file only
+        std::unordered_map<std::string, std::vector<std::string>> m_VariantKeywords;  // [variant name, enabled keywords]
+
+        struct PendingReload
+        {
+            std::future<Ref<Shader>> future;
+            bool stale = false;  // The source changed again while it was compiling
+        };
+
+        bool m_HotReload = false;
+        FileWatcher m_FileWatcher;
+        std::unordered_map<std::string, PendingReload> m_PendingReloads;  // [name, reload]
     };
 }
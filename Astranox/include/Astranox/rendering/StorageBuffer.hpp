@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Astranox/core/RefCounted.hpp"
+
+namespace Astranox
+{
+    /**
+     * Device-local buffer that shaders can read and write, e.g. particle state updated by a compute shader.
+     * It can also be bound as a vertex (instance) buffer or as the source of indirect draws.
+     */
+    class StorageBuffer: public RefCounted
+    {
+    public:
+        static Ref<StorageBuffer> create(uint32_t bytes);
+        virtual ~StorageBuffer() = default;
+
+        /**
+         * Upload `bytes` of `data` at `offset`. The copy lands before the next frame is rendered.
+         */
+        virtual void setData(const void* data, uint32_t bytes, uint32_t offset = 0) = 0;
+
+        virtual uint32_t getSize() const = 0;
+    };
+}
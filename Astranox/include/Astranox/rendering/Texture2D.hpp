@@ -8,7 +8,9 @@ namespace Astranox
     public:
         static Ref<Texture2D> create(const std::filesystem::path& path, bool enableMipMaps = false);
         static Ref<Texture2D> create(uint32_t width = 1, uint32_t height = 1, Buffer buffer = {});
-        virtual ~Texture2D() = default;
+
+        Texture2D();
+        virtual ~Texture2D();
 
         virtual uint32_t getWidth() const = 0;
         virtual uint32_t getHeight() const = 0;
@@ -17,7 +19,19 @@ namespace Astranox
 
         virtual const std::filesystem::path& getPath() const = 0;
 
+        /**
+         * @brief A small integer that identifies the texture while it is alive.
+         * IDs of destroyed textures are reused, so they stay dense and can index tables directly.
+         * When the bindless texture table is full, a texture borrows the ID of the white texture instead.
+         */
+        uint32_t getID() const { return m_ID; }
+        bool hasOwnID() const { return m_OwnsID; }
+
     public:
-        virtual bool operator==(const Texture2D& other) const = 0;
+        bool operator==(const Texture2D& other) const { return m_ID == other.m_ID; }
+
+    private:
+        uint32_t m_ID;
+        bool m_OwnsID = true;
     };
 }
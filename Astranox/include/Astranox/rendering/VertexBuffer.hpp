@@ -12,6 +12,14 @@ namespace Astranox
         virtual ~VertexBuffer() = default;
         
         virtual void setData(const void* data, uint32_t bytes) = 0;
+
+        /**
+         * Persistently mapped memory of a dynamic vertex buffer (created with `bytes` only),
+         * or nullptr for static buffers. Vertices can be written into it directly,
+         * followed by a call to flush().
+         */
+        virtual void* getMappedData() = 0;
+        virtual void flush(uint32_t bytes, uint32_t offset = 0) = 0;
     };
 }
 
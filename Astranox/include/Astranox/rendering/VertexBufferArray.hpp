@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Astranox/core/RefCounted.hpp"
+#include "VertexBuffer.hpp"
+
+namespace Astranox
+{
+    /**
+     * One dynamic vertex buffer per frame in flight,
+     * so that the CPU never writes into a buffer the GPU may still be reading.
+     */
+    class VertexBufferArray: public RefCounted
+    {
+    public:
+        static Ref<VertexBufferArray> create(uint32_t bytes);
+        virtual ~VertexBufferArray() = default;
+
+        virtual Ref<VertexBuffer> getBuffer(uint32_t frameIndex) = 0;
+        virtual Ref<VertexBuffer> getCurrentBuffer() = 0;
+    };
+}
@@ -31,6 +31,12 @@ project "Astranox"
             "AST_PLATFORM_WINDOWS",
         }
 
+	filter "system:linux"
+		pic "On"
+		defines {
+            "AST_PLATFORM_LINUX",
+        }
+
 	filter "configurations:Debug"
 		symbols "On"
 		defines {
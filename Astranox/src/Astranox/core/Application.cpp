@@ -2,11 +2,12 @@
 #include "Astranox/core/Application.hpp"
 #include "Astranox/rendering/Renderer.hpp"
 
-#include <GLFW/glfw3.h>
+#include <thread>
 
 namespace Astranox
 {
     Application::Application(const ApplicationSpecification& spec)
+        : m_Specification(spec)
     {
         s_Instance = this;
 
@@ -15,11 +16,17 @@ namespace Astranox
             std::filesystem::current_path(spec.workingDirectory);
         }
 
+        RendererConfig rendererConfig;
+        rendererConfig.framesInFlight = spec.framesInFlight;
+        rendererConfig.shaderHotReload = spec.shaderHotReload;
+        Renderer::setConfig(rendererConfig);
+
         WindowSpecification windowSpec;
         windowSpec.title = spec.name;
         windowSpec.width = spec.windowWidth;
         windowSpec.height = spec.windowHeight;
-        windowSpec.vsync = spec.vsync;
+        windowSpec.presentPolicy = spec.presentPolicy;
+        windowSpec.headless = spec.headless;
 
         m_Window = Window::create(windowSpec);
         // [Vulkan] The creation of Vulkan surface requires the window to be initialized first.
@@ -48,10 +55,11 @@ namespace Astranox
 
     void Application::run()
     {
+        m_Timer.reset();
+
         while (m_Running)
         {
-            // [TODO] Platform::getTime()
-            float time = static_cast<float>(glfwGetTime());
+            float time = m_Timer.getElapsedSeconds();
             Timestep timestep = time - m_LastFrameTime;
             m_LastFrameTime = time;
             //AST_CORE_DEBUG("Frame time: {0}ms ({1} fps)", timestep.getMilliseconds(), 1.0f / timestep.getSeconds());
@@ -59,10 +67,9 @@ namespace Astranox
             m_Window->pollEvents();
 
             float startTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
-            if (!m_Minimized)
+            // [NOTE] A frame whose image could not be acquired is skipped like a minimized one.
+            if (!m_Minimized && m_Window->beginFrame())
             {
-                m_Window->beginFrame();
-
                 // Update all layers
                 for (Layer* layer : m_LayerStack)
                 {
@@ -71,10 +78,35 @@ namespace Astranox
 
                 // Update the window
                 m_Window->swapBuffers();
-            }
 
-            m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % Renderer::getConfig().framesInFlight;
+                // [NOTE] Only rendered frames advance the index, so consecutive frames always use consecutive slots.
+                m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % Renderer::getConfig().framesInFlight;
+
+                m_FrameCount++;
+                if (m_Specification.maxFrames != 0 && m_FrameCount >= m_Specification.maxFrames)
+                {
+                    m_Running = false;
+                }
+            }
+            else
+            {
+                // Nothing is rendered while minimized, so don't spin on the event queue.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
         }
+
+        float elapsedSeconds = m_Timer.getElapsedSeconds();
+        AST_CORE_INFO("Rendered {0} frames in {1:.3f}s ({2:.3f}ms/frame, {3:.1f} fps)",
+            m_FrameCount,
+            elapsedSeconds,
+            m_FrameCount ? elapsedSeconds * 1000.0f / m_FrameCount : 0.0f,
+            elapsedSeconds > 0.0f ? m_FrameCount / elapsedSeconds : 0.0f
+        );
+    }
+
+    void Application::close()
+    {
+        m_Running = false;
     }
 
     void Application::onEvent(Event& evnt)
@@ -0,0 +1,56 @@
+#include "pch.hpp"
+#include "Astranox/core/FileWatcher.hpp"
+
+namespace Astranox
+{
+    namespace Utils
+    {
+        static std::filesystem::file_time_type getLastWriteTime(const std::filesystem::path& filepath)
+        {
+            std::error_code error;
+            std::filesystem::file_time_type time = std::filesystem::last_write_time(filepath, error);
+            return error ? std::filesystem::file_time_type::min() : time;
+        }
+    }
+
+    FileWatcher::FileWatcher(std::chrono::milliseconds interval)
+        : m_Interval(interval), m_LastPollTime(Clock::now())
+    {
+    }
+
+    void FileWatcher::watch(const std::filesystem::path& filepath)
+    {
+        m_Files.try_emplace(filepath.string(), Utils::getLastWriteTime(filepath));
+    }
+
+    void FileWatcher::unwatch(const std::filesystem::path& filepath)
+    {
+        m_Files.erase(filepath.string());
+    }
+
+    std::vector<std::filesystem::path> FileWatcher::poll()
+    {
+        std::vector<std::filesystem::path> changedFiles;
+
+        Clock::time_point now = Clock::now();
+        if (now - m_LastPollTime < m_Interval)
+        {
+            return changedFiles;
+        }
+        m_LastPollTime = now;
+
+        for (auto& [filepath, lastWriteTime] : m_Files)
+        {
+            std::filesystem::file_time_type writeTime = Utils::getLastWriteTime(filepath);
+            if (writeTime == std::filesystem::file_time_type::min() || writeTime == lastWriteTime)
+            {
+                continue;
+            }
+
+            lastWriteTime = writeTime;
+            changedFiles.emplace_back(filepath);
+        }
+
+        return changedFiles;
+    }
+}
@@ -0,0 +1,76 @@
+#include "pch.hpp"
+#include "Astranox/core/ThreadPool.hpp"
+
+namespace Astranox
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_Workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++)
+        {
+            m_Workers.emplace_back([this]() { workerLoop(); });
+        }
+        AST_CORE_DEBUG("Thread pool started with {0} workers.", threadCount);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_TaskAvailable.notify_all();
+
+        // [NOTE] Workers drain the queue before they exit, so every future gets its result.
+        for (auto& worker : m_Workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::waitIdle()
+    {
+        std::unique_lock lock(m_Mutex);
+        m_Idle.wait(lock, [this]() { return m_Tasks.empty() && m_RunningTaskCount == 0; });
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        s_IsWorkerThread = true;
+
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_TaskAvailable.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+
+                if (m_Tasks.empty())
+                {
+                    return;  // Stopping, and nothing left to do
+                }
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+                m_RunningTaskCount++;
+            }
+
+            task();
+
+            {
+                std::scoped_lock lock(m_Mutex);
+                m_RunningTaskCount--;
+                if (m_Tasks.empty() && m_RunningTaskCount == 0)
+                {
+                    m_Idle.notify_all();
+                }
+            }
+        }
+    }
+}
@@ -2,11 +2,17 @@
 
 #include "Astranox/core/Window.hpp"
 #include "Astranox/platform/windows/WindowsWindow.hpp"
+#include "Astranox/platform/headless/HeadlessWindow.hpp"
 
 namespace Astranox
 {
     std::unique_ptr<Window> Window::create(const WindowSpecification& spec)
     {
+        if (spec.headless)
+        {
+            return std::make_unique<HeadlessWindow>(spec);
+        }
+
 #ifdef AST_PLATFORM_WINDOWS
         return std::make_unique<WindowsWindow>(spec);
 #else
@@ -0,0 +1,47 @@
+#include "pch.hpp"
+#include "Astranox/platform/headless/HeadlessWindow.hpp"
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/platform/vulkan/VulkanSwapchain.hpp"
+
+namespace Astranox
+{
+    HeadlessWindow::HeadlessWindow(const WindowSpecification& spec)
+    {
+        m_Data.title = spec.title;
+        m_Data.width = spec.width;
+        m_Data.height = spec.height;
+        m_Data.presentPolicy = spec.presentPolicy;
+    }
+
+    void HeadlessWindow::init()
+    {
+        AST_CORE_INFO("Headless window created: {0} ({1}, {2})", m_Data.title, m_Data.width, m_Data.height);
+
+        m_Context = GraphicsContext::create(true);
+        m_Context->init(m_Data.width, m_Data.height);
+    }
+
+    void HeadlessWindow::destroy()
+    {
+        m_Context->destroy();
+        m_Context = nullptr;
+    }
+
+    void HeadlessWindow::onResize(uint32_t width, uint32_t height)
+    {
+        m_Data.width = width;
+        m_Data.height = height;
+
+        m_Context.as<VulkanContext>()->getSwapchain()->resize(width, height);
+    }
+
+    bool HeadlessWindow::beginFrame()
+    {
+        return m_Context.as<VulkanContext>()->getSwapchain()->beginFrame();
+    }
+
+    void HeadlessWindow::swapBuffers()
+    {
+        m_Context->swapBuffers();
+    }
+}
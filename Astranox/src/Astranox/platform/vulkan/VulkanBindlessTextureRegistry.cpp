@@ -0,0 +1,135 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanBindlessTextureRegistry.hpp"
+
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/platform/vulkan/VulkanDevice.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    VulkanBindlessTextureRegistry::VulkanBindlessTextureRegistry(Ref<VulkanDevice> device)
+        : m_Device(device)
+    {
+        const auto& limits = m_Device->getPhysicalDevice()->getDescriptorIndexingProperties();
+        m_Capacity = std::min({
+            s_MaxTextures,
+            limits.maxDescriptorSetUpdateAfterBindSampledImages,
+            limits.maxDescriptorSetUpdateAfterBindSamplers,
+            limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+            limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+        });
+        AST_CORE_INFO("Bindless texture table: {0} textures", m_Capacity);
+
+        // Descriptor set layout >>>
+        VkDescriptorSetLayoutBinding binding{
+            .binding = s_Binding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = m_Capacity,
+            .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
+            .pImmutableSamplers = nullptr,
+        };
+
+        VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+                                              | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                                              | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            .pNext = nullptr,
+            .bindingCount = 1,
+            .pBindingFlags = &bindingFlags,
+        };
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext = &bindingFlagsInfo,
+            .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+            .bindingCount = 1,
+            .pBindings = &binding,
+        };
+        VK_CHECK(::vkCreateDescriptorSetLayout(m_Device->getRaw(), &layoutInfo, nullptr, &m_DescriptorSetLayout));
+        // <<< Descriptor set layout
+
+        // Descriptor pool >>>
+        VkDescriptorPoolSize poolSize{
+            .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = m_Capacity,
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            .maxSets = 1,
+            .poolSizeCount = 1,
+            .pPoolSizes = &poolSize,
+        };
+        VK_CHECK(::vkCreateDescriptorPool(m_Device->getRaw(), &poolInfo, nullptr, &m_DescriptorPool));
+        // <<< Descriptor pool
+
+        // Descriptor set >>>
+        VkDescriptorSetAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool = m_DescriptorPool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &m_DescriptorSetLayout,
+        };
+        VK_CHECK(::vkAllocateDescriptorSets(m_Device->getRaw(), &allocInfo, &m_DescriptorSet));
+        // <<< Descriptor set
+    }
+
+    void VulkanBindlessTextureRegistry::destroy()
+    {
+        ::vkDestroyDescriptorPool(m_Device->getRaw(), m_DescriptorPool, nullptr);
+        ::vkDestroyDescriptorSetLayout(m_Device->getRaw(), m_DescriptorSetLayout, nullptr);
+
+        m_DescriptorPool = VK_NULL_HANDLE;
+        m_DescriptorSetLayout = VK_NULL_HANDLE;
+        m_DescriptorSet = VK_NULL_HANDLE;
+    }
+
+    uint32_t VulkanBindlessTextureRegistry::allocateIndex()
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        if (!m_FreeIndices.empty())
+        {
+            uint32_t index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+            return index;
+        }
+
+        return m_NextIndex < m_Capacity ? m_NextIndex++ : s_InvalidIndex;
+    }
+
+    void VulkanBindlessTextureRegistry::releaseIndex(uint32_t index)
+    {
+        // [NOTE] The deletion queue is flushed before the registry is destroyed (see VulkanContext::destroy).
+        VulkanContext::get()->getDeletionQueue()->push(
+            [this, index]() {
+                std::scoped_lock lock(m_Mutex);
+                m_FreeIndices.push_back(index);
+            }
+        );
+    }
+
+    void VulkanBindlessTextureRegistry::registerTexture(uint32_t index, const VkDescriptorImageInfo& imageInfo)
+    {
+        if (index >= m_Capacity)
+        {
+            AST_CORE_ERROR("Texture index {0} exceeds the bindless texture table ({1})!", index, m_Capacity);
+            return;
+        }
+
+        VkWriteDescriptorSet write{
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = m_DescriptorSet,
+            .dstBinding = s_Binding,
+            .dstArrayElement = index,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImageInfo = &imageInfo,
+        };
+
+        std::scoped_lock lock(m_Mutex);
+        ::vkUpdateDescriptorSets(m_Device->getRaw(), 1, &write, 0, nullptr);
+    }
+}
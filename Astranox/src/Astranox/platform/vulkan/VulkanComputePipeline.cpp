@@ -0,0 +1,57 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanComputePipeline.hpp"
+
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    VulkanComputePipeline::VulkanComputePipeline(Ref<Shader> shader)
+        : m_Shader(shader)
+    {
+        init();
+    }
+
+    VulkanComputePipeline::~VulkanComputePipeline()
+    {
+        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
+
+        VulkanContext::get()->getDeletionQueue()->push([device, pipeline = m_Pipeline, pipelineLayout = m_PipelineLayout]() {
+            ::vkDestroyPipeline(device, pipeline, nullptr);
+            ::vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        });
+    }
+
+    void VulkanComputePipeline::init()
+    {
+        auto device = VulkanContext::get()->getDevice();
+
+        Ref<VulkanShader> shader = m_Shader.as<VulkanShader>();
+        AST_CORE_ASSERT(shader->isCompute(), "Shader {0} is not a compute shader!", shader->getName());
+
+        const auto& descriptorSetLayouts = shader->getDescriptorSetLayouts();
+        const auto& pushConstantRanges = shader->getPushConstantRanges();
+
+        // Pipeline Layout >>>
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size()),
+            .pSetLayouts = descriptorSetLayouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size()),
+            .pPushConstantRanges = pushConstantRanges.data(),
+        };
+        VK_CHECK(::vkCreatePipelineLayout(device->getRaw(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout));
+        // <<< Pipeline Layout
+
+        // Pipeline >>>
+        VkComputePipelineCreateInfo pipelineInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .stage = shader->getShaderStageCreateInfos()[0],
+            .layout = m_PipelineLayout,
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex = -1,
+        };
+        m_Pipeline = device->getPipelineCache()->createComputePipeline(pipelineInfo);
+        // <<< Pipeline
+    }
+}
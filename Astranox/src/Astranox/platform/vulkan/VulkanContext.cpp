@@ -107,10 +107,15 @@ namespace Astranox
 
     static Ref<VulkanContext> s_ContextInstance = nullptr;
 
+    VulkanContext::VulkanContext(bool headless)
+        : m_Headless(headless)
+    {
+    }
+
     void VulkanContext::init(uint32_t& width, uint32_t& height)
     {
         s_ContextInstance = this;
-        AST_CORE_INFO("Creating Vulkan context...");
+        AST_CORE_INFO("Creating Vulkan context{0}...", m_Headless ? " (headless)" : "");
 
         createInstance();
 
@@ -120,12 +125,19 @@ namespace Astranox
         }
 
         m_PhysicalDevice = VulkanPhysicalDevice::pick();
-        m_Device = Ref<VulkanDevice>::create(m_PhysicalDevice);
+        m_Device = Ref<VulkanDevice>::create(m_PhysicalDevice, m_Headless);
 
         VulkanMemoryAllocator::init(m_Device);
 
-        m_Swapchain = Ref<VulkanSwapchain>::create(m_Device);
-        m_Swapchain->createSurface();
+        m_DeletionQueue = Ref<VulkanDeletionQueue>::create();
+        m_BindlessTextureRegistry = Ref<VulkanBindlessTextureRegistry>::create(m_Device);
+        m_UploadManager = Ref<VulkanUploadManager>::create(m_Device);
+
+        m_Swapchain = Ref<VulkanSwapchain>::create(m_Device, m_Headless);
+        if (!m_Headless)
+        {
+            m_Swapchain->createSurface();
+        }
         m_Swapchain->createSwapchain(width, height);
     }
 
@@ -134,6 +146,16 @@ namespace Astranox
         m_Swapchain->destroy();
         m_Swapchain = nullptr;
 
+        // The device is idle after the swapchain has been destroyed.
+        m_DeletionQueue->destroy();
+        m_DeletionQueue = nullptr;
+
+        m_UploadManager->destroy();
+        m_UploadManager = nullptr;
+
+        m_BindlessTextureRegistry->destroy();
+        m_BindlessTextureRegistry = nullptr;
+
         VulkanMemoryAllocator::shutdown();
 
         m_Device->destroy();
@@ -155,6 +177,8 @@ namespace Astranox
 
     void VulkanContext::swapBuffers()
     {
+        // Uploads recorded during the frame have to be on the queue before the frame that samples them.
+        m_UploadManager->flush();
         m_Swapchain->present();
     }
 
@@ -198,9 +222,13 @@ namespace Astranox
 
 
         // --------------------- Extensions  ---------------------
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions = ::glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-        std::vector<const char*> requiredExtensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        // [NOTE] A headless context presents nothing, so it needs no surface extensions (and GLFW is never initialized).
+        std::vector<const char*> requiredExtensions;
+        if (!m_Headless) {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions = ::glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            requiredExtensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
         if (VK_ENABLE_VALIDATION_LAYERS) {
             requiredExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
         }
@@ -0,0 +1,61 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanDeletionQueue.hpp"
+#include "Astranox/rendering/Renderer.hpp"
+
+namespace Astranox
+{
+    void VulkanDeletionQueue::destroy()
+    {
+        flush();
+    }
+
+    void VulkanDeletionQueue::push(std::function<void()>&& deleter)
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Entries.push_back({ m_FrameNumber, std::move(deleter) });
+    }
+
+    void VulkanDeletionQueue::beginFrame()
+    {
+        std::vector<std::function<void()>> deleters;
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_FrameNumber++;
+
+            // [NOTE] The fence just waited on belongs to frame (m_FrameNumber - framesInFlight),
+            //        and the fences of all earlier frames have been waited on before.
+            uint64_t framesInFlight = Renderer::getConfig().framesInFlight;
+            if (m_FrameNumber < framesInFlight)
+            {
+                return;
+            }
+            uint64_t completedFrame = m_FrameNumber - framesInFlight;
+
+            while (!m_Entries.empty() && m_Entries.front().frame <= completedFrame)
+            {
+                deleters.push_back(std::move(m_Entries.front().deleter));
+                m_Entries.pop_front();
+            }
+        }
+
+        // Deleters run outside the lock, so they are free to push again.
+        for (auto& deleter : deleters)
+        {
+            deleter();
+        }
+    }
+
+    void VulkanDeletionQueue::flush()
+    {
+        std::deque<Entry> entries;
+        {
+            std::scoped_lock lock(m_Mutex);
+            entries.swap(m_Entries);
+        }
+
+        for (auto& entry : entries)
+        {
+            entry.deleter();
+        }
+    }
+}
@@ -0,0 +1,359 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanDescriptorAllocator.hpp"
+
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    /**
+     * Descriptors reserved per set in a pool, i.e. the pool sizes are these ratios times the number of sets.
+     */
+    static constexpr std::array<std::pair<VkDescriptorType, uint32_t>, 5> s_DescriptorRatios = { {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 },
+    } };
+
+    namespace Utils
+    {
+        static const char* descriptorTypeToString(VkDescriptorType type)
+        {
+            switch (type)
+            {
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: { return "uniform buffer"; }
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC: { return "dynamic uniform buffer"; }
+                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: { return "combined image sampler"; }
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: { return "storage buffer"; }
+                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: { return "storage image"; }
+            }
+            return "other";
+        }
+
+        static void addUsage(std::map<VkDescriptorType, VulkanDescriptorAllocator::DescriptorUsage>& usage,
+            const std::map<VkDescriptorType, uint32_t>& capacity, const std::map<VkDescriptorType, uint32_t>& used)
+        {
+            for (auto& [type, count] : capacity)
+            {
+                usage[type].capacity += count;
+            }
+            for (auto& [type, count] : used)
+            {
+                usage[type].used += count;
+            }
+        }
+    }
+
+    VulkanDescriptorAllocator::VulkanDescriptorAllocator(VkDevice device)
+        : m_Device(device)
+    {
+    }
+
+    void VulkanDescriptorAllocator::destroy()
+    {
+        Statistics stats = getStats();
+        AST_CORE_INFO("Descriptor allocator: {0} sets in {1} pools ({2:.1f}% used), {3} transient pools ({4:.1f}% used), {5} dedicated pools",
+            stats.setCount, stats.poolCount, stats.getUtilization() * 100.0f,
+            stats.transientPoolCount, stats.getTransientUtilization() * 100.0f, stats.dedicatedPoolCount);
+        for (auto& [type, usage] : stats.descriptors)
+        {
+            AST_CORE_DEBUG("    {0}: {1}/{2} descriptors ({3:.1f}% used)",
+                Utils::descriptorTypeToString(type), usage.used, usage.capacity, usage.getUtilization() * 100.0f);
+        }
+
+        std::scoped_lock lock(m_Mutex);
+
+        for (auto& pool : m_Pools.pools)
+        {
+            ::vkDestroyDescriptorPool(m_Device, pool.pool, nullptr);
+        }
+        m_Pools = {};
+        m_SetOwners.clear();
+
+        for (auto& [descriptorSet, pool] : m_DedicatedPools)
+        {
+            ::vkDestroyDescriptorPool(m_Device, pool, nullptr);
+        }
+        m_DedicatedPools.clear();
+
+        for (auto& framePools : m_FramePools)
+        {
+            for (auto& pool : framePools.chain.pools)
+            {
+                ::vkDestroyDescriptorPool(m_Device, pool.pool, nullptr);
+            }
+            for (VkDescriptorPool pool : framePools.dedicatedPools)
+            {
+                ::vkDestroyDescriptorPool(m_Device, pool, nullptr);
+            }
+        }
+        m_FramePools.clear();
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocate(VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        if (!fitsSharedPool(poolSizes))
+        {
+            VkDescriptorPool pool = VK_NULL_HANDLE;
+            VkDescriptorSet descriptorSet = allocateDedicated(layout, poolSizes, pool);
+            m_DedicatedPools[descriptorSet] = pool;
+
+            return descriptorSet;
+        }
+
+        uint32_t poolIndex = 0;
+        VkDescriptorSet descriptorSet = allocateFromChain(m_Pools, layout, poolSizes, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, poolIndex);
+        m_SetOwners[descriptorSet] = { poolIndex, poolSizes };
+
+        return descriptorSet;
+    }
+
+    void VulkanDescriptorAllocator::free(VkDescriptorSet descriptorSet)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        auto dedicatedIt = m_DedicatedPools.find(descriptorSet);
+        if (dedicatedIt != m_DedicatedPools.end())
+        {
+            ::vkDestroyDescriptorPool(m_Device, dedicatedIt->second, nullptr);
+            m_DedicatedPools.erase(dedicatedIt);
+            return;
+        }
+
+        auto it = m_SetOwners.find(descriptorSet);
+        AST_CORE_ASSERT(it != m_SetOwners.end(), "Descriptor set was not allocated by this allocator!");
+
+        const SetOwner& owner = it->second;
+        Pool& pool = m_Pools.pools[owner.poolIndex];
+        VK_CHECK(::vkFreeDescriptorSets(m_Device, pool.pool, 1, &descriptorSet));
+        pool.allocated--;
+        for (const VkDescriptorPoolSize& poolSize : owner.descriptors)
+        {
+            pool.descriptorsUsed[poolSize.type] -= poolSize.descriptorCount;
+        }
+
+        // The pool has room again
+        m_Pools.currentPool = std::min(m_Pools.currentPool, owner.poolIndex);
+
+        m_SetOwners.erase(it);
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocateTransient(uint32_t frameIndex, VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        if (frameIndex >= m_FramePools.size())
+        {
+            m_FramePools.resize(frameIndex + 1);
+        }
+        FramePools& framePools = m_FramePools[frameIndex];
+
+        if (!fitsSharedPool(poolSizes))
+        {
+            VkDescriptorPool pool = VK_NULL_HANDLE;
+            VkDescriptorSet descriptorSet = allocateDedicated(layout, poolSizes, pool);
+            framePools.dedicatedPools.push_back(pool);
+
+            return descriptorSet;
+        }
+
+        // [NOTE] Transient sets are never freed one by one, so their pools do not need FREE_DESCRIPTOR_SET.
+        uint32_t poolIndex = 0;
+        return allocateFromChain(framePools.chain, layout, poolSizes, 0, poolIndex);
+    }
+
+    void VulkanDescriptorAllocator::resetFrame(uint32_t frameIndex)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        if (frameIndex >= m_FramePools.size())
+        {
+            return;
+        }
+
+        FramePools& framePools = m_FramePools[frameIndex];
+        for (auto& pool : framePools.chain.pools)
+        {
+            if (pool.allocated == 0)
+            {
+                continue;
+            }
+
+            VK_CHECK(::vkResetDescriptorPool(m_Device, pool.pool, 0));
+            pool.allocated = 0;
+            pool.descriptorsUsed.clear();
+        }
+        framePools.chain.currentPool = 0;
+
+        for (VkDescriptorPool pool : framePools.dedicatedPools)
+        {
+            ::vkDestroyDescriptorPool(m_Device, pool, nullptr);
+        }
+        framePools.dedicatedPools.clear();
+    }
+
+    VulkanDescriptorAllocator::Statistics VulkanDescriptorAllocator::getStats() const
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        Statistics stats;
+        for (const auto& pool : m_Pools.pools)
+        {
+            stats.poolCount++;
+            stats.setCount += pool.allocated;
+            stats.setCapacity += pool.capacity;
+            Utils::addUsage(stats.descriptors, pool.descriptorCapacity, pool.descriptorsUsed);
+        }
+        stats.dedicatedPoolCount = static_cast<uint32_t>(m_DedicatedPools.size());
+
+        for (const auto& framePools : m_FramePools)
+        {
+            for (const auto& pool : framePools.chain.pools)
+            {
+                stats.transientPoolCount++;
+                stats.transientSetCount += pool.allocated;
+                stats.transientSetCapacity += pool.capacity;
+                Utils::addUsage(stats.transientDescriptors, pool.descriptorCapacity, pool.descriptorsUsed);
+            }
+            stats.dedicatedPoolCount += static_cast<uint32_t>(framePools.dedicatedPools.size());
+        }
+
+        return stats;
+    }
+
+    bool VulkanDescriptorAllocator::fitsSharedPool(const std::vector<VkDescriptorPoolSize>& poolSizes)
+    {
+        // [NOTE] A freshly appended pool holds at least s_InitialSetsPerPool sets, so this is what it can always provide.
+        for (const VkDescriptorPoolSize& poolSize : poolSizes)
+        {
+            auto it = std::find_if(s_DescriptorRatios.begin(), s_DescriptorRatios.end(),
+                [&poolSize](const auto& ratio) { return ratio.first == poolSize.type; });
+            if (it == s_DescriptorRatios.end() || poolSize.descriptorCount > it->second * s_InitialSetsPerPool)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    VulkanDescriptorAllocator::Pool VulkanDescriptorAllocator::createPool(uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPoolCreateFlags flags)
+    {
+        VkDescriptorPoolCreateInfo poolInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .flags = flags,
+            .maxSets = maxSets,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data()
+        };
+
+        Pool pool;
+        pool.capacity = maxSets;
+        for (const VkDescriptorPoolSize& poolSize : poolSizes)
+        {
+            pool.descriptorCapacity[poolSize.type] += poolSize.descriptorCount;
+        }
+        VK_CHECK(::vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &pool.pool));
+
+        return pool;
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocateDedicated(VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPool& pool)
+    {
+        // [NOTE] The pool is destroyed along with its only set, so it never frees sets.
+        pool = createPool(1, poolSizes, 0).pool;
+
+        VkDescriptorSetAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool = pool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &layout
+        };
+
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        VK_CHECK(::vkAllocateDescriptorSets(m_Device, &allocInfo, &descriptorSet));
+        return descriptorSet;
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocateFromChain(PoolChain& chain, VkDescriptorSetLayout layout, const std::vector<VkDescriptorPoolSize>& poolSizes,
+        VkDescriptorPoolCreateFlags flags, uint32_t& poolIndex)
+    {
+        auto useDescriptors = [&poolSizes](Pool& pool)
+        {
+            pool.allocated++;
+            for (const VkDescriptorPoolSize& poolSize : poolSizes)
+            {
+                pool.descriptorsUsed[poolSize.type] += poolSize.descriptorCount;
+            }
+        };
+
+        VkDescriptorSetAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &layout
+        };
+
+        // [NOTE] A pool may run out of descriptors of one type before it runs out of sets, and it still serves sets
+        //      of other types. The cursor therefore only skips pools that are out of sets.
+        for (uint32_t index = chain.currentPool; index < chain.pools.size(); ++index)
+        {
+            Pool& pool = chain.pools[index];
+            if (pool.allocated >= pool.capacity)
+            {
+                continue;
+            }
+
+            allocInfo.descriptorPool = pool.pool;
+
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+            VkResult result = ::vkAllocateDescriptorSets(m_Device, &allocInfo, &descriptorSet);
+            if (result == VK_SUCCESS)
+            {
+                useDescriptors(pool);
+                poolIndex = index;
+                advanceCursor(chain);
+                return descriptorSet;
+            }
+
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+            {
+                VK_CHECK(result);
+            }
+        }
+
+        // No pool can hold the set: append a larger one
+        uint32_t maxSets = chain.pools.empty()
+            ? s_InitialSetsPerPool
+            : std::min(chain.pools.back().capacity * 2, s_MaxSetsPerPool);
+
+        std::vector<VkDescriptorPoolSize> sharedPoolSizes;
+        for (auto [type, ratio] : s_DescriptorRatios)
+        {
+            sharedPoolSizes.push_back({ type, ratio * maxSets });
+        }
+
+        chain.pools.push_back(createPool(maxSets, sharedPoolSizes, flags));
+
+        Pool& pool = chain.pools.back();
+        allocInfo.descriptorPool = pool.pool;
+
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        VK_CHECK(::vkAllocateDescriptorSets(m_Device, &allocInfo, &descriptorSet));
+        useDescriptors(pool);
+        poolIndex = static_cast<uint32_t>(chain.pools.size() - 1);
+        advanceCursor(chain);
+
+        return descriptorSet;
+    }
+
+    void VulkanDescriptorAllocator::advanceCursor(PoolChain& chain)
+    {
+        while (chain.currentPool < chain.pools.size()
+            && chain.pools[chain.currentPool].allocated >= chain.pools[chain.currentPool].capacity)
+        {
+            chain.currentPool++;
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #include "Astranox/platform/vulkan/VulkanUniformBuffer.hpp"
 #include "Astranox/platform/vulkan/VulkanShader.hpp"
 #include "Astranox/platform/vulkan/VulkanTexture2D.hpp"
+#include "Astranox/platform/vulkan/VulkanStorageBuffer.hpp"
 #include "Astranox/platform/vulkan/VulkanUtils.hpp"
 
 #include "Astranox/rendering/Renderer.hpp"
@@ -20,6 +21,10 @@ namespace Astranox
                 return RenderPassResourceType::UniformBuffer;
             case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
                 return RenderPassResourceType::Texture2D;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return RenderPassResourceType::StorageBuffer;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                return RenderPassResourceType::Image2D;
         }
 
         AST_CORE_ASSERT(false, "Unknown descriptor type");
@@ -35,6 +40,10 @@ namespace Astranox
                 return RenderPassInputType::UniformBuffer;
             case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
                 return RenderPassInputType::ImageSampler2D;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return RenderPassInputType::StorageBuffer;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                return RenderPassInputType::StorageImage2D;
         }
 
         AST_CORE_ASSERT(false, "Unknown descriptor type");
@@ -42,154 +51,252 @@ namespace Astranox
     }
 
 
-    VulkanDescriptorManager::VulkanDescriptorManager(Ref<Shader> shader)
-        : m_Shader(shader)
+    VulkanDescriptorManager::VulkanDescriptorManager(Ref<Shader> shader, bool transient)
+        : m_Shader(shader), m_Transient(transient)
     {
         uint32_t framesInFlight = Renderer::getConfig().framesInFlight;
         m_WriteDescriptorMap.resize(framesInFlight);
+        m_DirtyBindings.resize(framesInFlight);
 
-        auto& descriptorSetInfo = shader.as<VulkanShader>()->getDescriptorSetInfo();
+        const auto& descriptorSetInfos = shader.as<VulkanShader>()->getDescriptorSetInfos();
 
-        uint32_t set = 0;  // [TODO] Support multiple descriptor sets
-        for (auto&& [name, wd] : descriptorSetInfo.writeDescriptorSets)
+        for (uint32_t set = 0; set < descriptorSetInfos.size(); ++set)
         {
-            uint32_t binding = wd.dstBinding;
+            for (auto&& [name, wd] : descriptorSetInfos[set].writeDescriptorSets)
+            {
+                uint32_t binding = wd.dstBinding;
+
+                RenderPassInputDeclaration& inputDecl = m_RenderPassInputDeclarations[name];
+                inputDecl.set = set;
+                inputDecl.binding = binding;
+                inputDecl.count = wd.descriptorCount;
+                inputDecl.name = name;
+                inputDecl.type = VulkanDescriptorTypeToRenderPassInputType(wd.descriptorType);
+
+                RenderPassInput& input = m_RenderPassInputResources[set][binding];
+                input.input.resize(wd.descriptorCount);
+                input.type = VulkanDescriptorTypeToRenderPassResourceType(wd.descriptorType);
+
+                if (inputDecl.type == RenderPassInputType::ImageSampler2D)
+                {
+                    for (auto& texture: input.input)
+                    {
+                        texture = Renderer::getWhiteTexture();
+                    }
+                }
 
-            RenderPassInputDeclaration& inputDecl = m_RenderPassInputDeclarations[name];
-            inputDecl.set = set;
-            inputDecl.binding = binding;
-            inputDecl.count = wd.descriptorCount;
-            inputDecl.name = name;
-            inputDecl.type = VulkanDescriptorTypeToRenderPassInputType(wd.descriptorType);
+                for (uint32_t frameIndex = 0; frameIndex < framesInFlight; ++frameIndex)
+                {
+                    m_WriteDescriptorMap[frameIndex][set][binding] = wd;
+                }
+
+                // Nothing has been written yet
+                markDirty(set, binding);
+            }
+        }
+
+        allocateDescriptorSets();
+    }
 
-            RenderPassInput& input = m_RenderPassInputResources[set][binding];
-            input.input.resize(wd.descriptorCount);
-            input.type = VulkanDescriptorTypeToRenderPassResourceType(wd.descriptorType);
+    VulkanDescriptorManager::~VulkanDescriptorManager()
+    {
+        Ref<VulkanShader> shader = m_Shader.as<VulkanShader>();
 
-            if (inputDecl.type == RenderPassInputType::ImageSampler2D)
+        std::vector<VkDescriptorSet> descriptorSets;
+        for (auto& frameDescriptorSets : m_DescriptorSets)
+        {
+            for (uint32_t set = 0; set < frameDescriptorSets.size(); ++set)
             {
-                for (auto& texture: input.input)
+                // Transient sets are released with their frame
+                if (!m_Transient && !shader->isBindlessTextureSet(set))
                 {
-                    texture = Renderer::getWhiteTexture();
+                    descriptorSets.push_back(frameDescriptorSets[set]);
                 }
             }
+        }
+
+        // Command buffers in flight may still bind the sets.
+        VulkanContext::get()->getDeletionQueue()->push([descriptorSets = std::move(descriptorSets)]() {
+            auto descriptorAllocator = VulkanContext::get()->getDevice()->getDescriptorAllocator();
+            for (VkDescriptorSet descriptorSet : descriptorSets)
+            {
+                descriptorAllocator->free(descriptorSet);
+            }
+        });
+    }
+
+    void VulkanDescriptorManager::allocateDescriptorSets()
+    {
+        auto descriptorAllocator = VulkanContext::get()->getDevice()->getDescriptorAllocator();
+        uint32_t framesInFlight = Renderer::getConfig().framesInFlight;
+
+        m_DescriptorSets.resize(framesInFlight);
 
+        // [NOTE] One set is allocated for every layout of the shader, even empty ones, so the sets can be bound in one call.
+        //      The slot of the bindless texture table refers to the engine-wide set, which is not freed by this manager.
+        //      Transient sets are only allocated by upload().
+        Ref<VulkanShader> shader = m_Shader.as<VulkanShader>();
+        const auto& layouts = shader->getDescriptorSetLayouts();
+        for (uint32_t set = 0; set < layouts.size(); ++set)
+        {
             for (uint32_t frameIndex = 0; frameIndex < framesInFlight; ++frameIndex)
             {
-                m_WriteDescriptorMap[frameIndex][set][binding] = wd;
+                VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+                if (shader->isBindlessTextureSet(set))
+                {
+                    descriptorSet = VulkanContext::get()->getBindlessTextureRegistry()->getDescriptorSet();
+                }
+                else if (!m_Transient)
+                {
+                    descriptorSet = descriptorAllocator->allocate(layouts[set], shader->getDescriptorPoolSizes(set));
+                }
+                m_DescriptorSets[frameIndex].push_back(descriptorSet);
+            }
+        }
+    }
+
+    void VulkanDescriptorManager::allocateTransientDescriptorSets(uint32_t frameIndex)
+    {
+        auto descriptorAllocator = VulkanContext::get()->getDevice()->getDescriptorAllocator();
+
+        Ref<VulkanShader> shader = m_Shader.as<VulkanShader>();
+        const auto& layouts = shader->getDescriptorSetLayouts();
+        for (uint32_t set = 0; set < layouts.size(); ++set)
+        {
+            if (shader->isBindlessTextureSet(set))
+            {
+                continue;
             }
+
+            m_DescriptorSets[frameIndex][set] = descriptorAllocator->allocateTransient(frameIndex, layouts[set], shader->getDescriptorPoolSizes(set));
         }
 
-        // Descriptor pool >>>
-        std::vector<VkDescriptorPoolSize> poolSizes{
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1000 },            // Uniform buffer
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1000 },    // Uniform buffer dynamic
-            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000 },    // Image sampler
-        };
-
-        VkDescriptorPoolCreateInfo poolInfo{
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
-            .maxSets = 1000,
-            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
-            .pPoolSizes = poolSizes.data()
-        };
-
-        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
-        VK_CHECK(::vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_DescriptorPool));
-        // <<< Descriptor pool
+        // A fresh set holds nothing, so every binding is written
+        auto& dirtyBindings = m_DirtyBindings[frameIndex];
+        for (const auto& [set, inputs] : m_RenderPassInputResources)
+        {
+            for (const auto& [binding, input] : inputs)
+            {
+                dirtyBindings[set].insert(binding);
+            }
+        }
     }
 
-    VulkanDescriptorManager::~VulkanDescriptorManager()
+    void VulkanDescriptorManager::markDirty(uint32_t set, uint32_t binding)
     {
-        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
-        ::vkDestroyDescriptorPool(device, m_DescriptorPool, nullptr);
+        for (auto& dirtyBindings : m_DirtyBindings)
+        {
+            dirtyBindings[set].insert(binding);
+        }
     }
 
     void VulkanDescriptorManager::upload()
     {
+        uint32_t frameIndex = Renderer::getCurrentFrameIndex();
+
+        if (m_Transient)
+        {
+            allocateTransientDescriptorSets(frameIndex);
+        }
+
+        auto& dirtyBindings = m_DirtyBindings[frameIndex];
+        if (dirtyBindings.empty())
+        {
+            return;
+        }
+
         auto device = VulkanContext::get()->getDevice();
-        uint32_t framesInFlight = Renderer::getConfig().framesInFlight;
 
-        m_DescriptorSets.clear();
-        m_DescriptorSets.resize(framesInFlight);
+        size_t dirtyCount = 0;
+        for (const auto& [set, bindings] : dirtyBindings)
+        {
+            dirtyCount += bindings.size();
+        }
 
-        for (const auto& [set, inputs] : m_RenderPassInputResources)
+        // [NOTE] The writes point into `imageInfos`, so it must not reallocate while they are recorded.
+        std::vector<VkWriteDescriptorSet> writeDescriptors;
+        std::vector<std::vector<VkDescriptorImageInfo>> imageInfos;
+        writeDescriptors.reserve(dirtyCount);
+        imageInfos.reserve(dirtyCount);
+
+        for (const auto& [set, bindings] : dirtyBindings)
         {
-            auto layout = m_Shader.as<VulkanShader>()->getDescriptorSetLayout(set);
+            VkDescriptorSet descriptorSet = m_DescriptorSets[frameIndex][set];
+            auto& writeDescriptorMap = m_WriteDescriptorMap[frameIndex].at(set);
+            const auto& inputs = m_RenderPassInputResources.at(set);
 
-            for (uint32_t frameIndex = 0; frameIndex < framesInFlight; ++frameIndex)
+            for (uint32_t binding : bindings)
             {
-                // Descriptor set >>>
-                VkDescriptorSetAllocateInfo allocInfo{
-                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-                    .descriptorPool = m_DescriptorPool,
-                    .descriptorSetCount = 1,
-                    .pSetLayouts = &layout
-                };
-
-                VkDescriptorSet& descriptorSet = m_DescriptorSets[frameIndex].emplace_back();
-                VK_CHECK(::vkAllocateDescriptorSets(device->getRaw(), &allocInfo, &descriptorSet));
-                // <<< Descriptor set
-
-                // Descriptor writes >>>
-                auto& writeDescriptorMap = m_WriteDescriptorMap.at(frameIndex).at(set);
-                std::vector<std::vector<VkDescriptorImageInfo>> imageInfos;
-                uint32_t imageInfoIndex = 0;
-
-                for (const auto& [binding, input] : inputs)
+                const RenderPassInput& input = inputs.at(binding);
+
+                // [NOTE] Storage resources have no default, so they are written once they are set.
+                if (!input.input[0])
                 {
-                    auto& wd = writeDescriptorMap.at(binding);
-                    wd.dstSet = descriptorSet;
+                    continue;
+                }
 
-                    switch (input.type)
-                    {
-                    case RenderPassResourceType::UniformBuffer:
-                    {
-                        auto ub = input.input[0].as<VulkanUniformBuffer>();
-                        wd.pBufferInfo = &ub->getDescriptorBufferInfo();
-                        break;
-                    }
-                    case RenderPassResourceType::UniformBufferArray:
-                    {
-                        auto uba = input.input[0].as<VulkanUniformBufferArray>();
-                        auto ub = uba->getCurrentBuffer().as<VulkanUniformBuffer>();
-                        wd.pBufferInfo = &ub->getDescriptorBufferInfo();
-                        break;
-                    }
-                    case RenderPassResourceType::Texture2D:
+                auto& wd = writeDescriptorMap.at(binding);
+                wd.dstSet = descriptorSet;
+
+                switch (input.type)
+                {
+                case RenderPassResourceType::UniformBuffer:
+                {
+                    auto ub = input.input[0].as<VulkanUniformBuffer>();
+                    wd.pBufferInfo = &ub->getDescriptorBufferInfo();
+                    break;
+                }
+                case RenderPassResourceType::UniformBufferArray:
+                {
+                    // Each frame slot points at its own buffer of the array
+                    auto uba = input.input[0].as<VulkanUniformBufferArray>();
+                    auto ub = uba->getBuffer(frameIndex).as<VulkanUniformBuffer>();
+                    wd.pBufferInfo = &ub->getDescriptorBufferInfo();
+                    break;
+                }
+                case RenderPassResourceType::Texture2D:
+                {
+                    auto& infos = imageInfos.emplace_back(input.input.size());
+                    for (uint32_t i = 0; i < input.input.size(); ++i)
                     {
-                        imageInfos.emplace_back(input.input.size());
-                        for (uint32_t i = 0; i < input.input.size(); ++i)
-                        {
-                            auto texture = input.input[i].as<VulkanTexture2D>();
-                            imageInfos[imageInfoIndex][i] = texture->getDescriptorImageInfo();
-                        }
-                        wd.pImageInfo = imageInfos[imageInfoIndex].data();
-                        ++imageInfoIndex;
-                        break;
+                        auto texture = input.input[i].as<VulkanTexture2D>();
+                        infos[i] = texture->getDescriptorImageInfo();
                     }
-                    }
-
+                    wd.pImageInfo = infos.data();
+                    break;
                 }
-                std::vector<VkWriteDescriptorSet> writeDescriptors;
-                for (auto&& [binding, wd]: writeDescriptorMap)
+                case RenderPassResourceType::StorageBuffer:
                 {
-                    writeDescriptors.push_back(wd);
+                    auto sb = input.input[0].as<VulkanStorageBuffer>();
+                    wd.pBufferInfo = &sb->getDescriptorBufferInfo();
+                    break;
                 }
-                
-                if (!writeDescriptors.empty())
+                case RenderPassResourceType::Image2D:
                 {
-                    ::vkUpdateDescriptorSets(
-                        device->getRaw(),
-                        static_cast<uint32_t>(writeDescriptors.size()),
-                        writeDescriptors.data(),
-                        0,
-                        nullptr);
+                    auto& infos = imageInfos.emplace_back(input.input.size());
+                    for (uint32_t i = 0; i < input.input.size(); ++i)
+                    {
+                        // Unset elements repeat the first image
+                        auto image = (input.input[i] ? input.input[i] : input.input[0]).as<VulkanImage2D>();
+                        infos[i] = image->getDescriptorImageInfo();
+                    }
+                    wd.pImageInfo = infos.data();
+                    break;
                 }
+                }
+
+                writeDescriptors.push_back(wd);
             }
         }
-        
+
+        ::vkUpdateDescriptorSets(
+            device->getRaw(),
+            static_cast<uint32_t>(writeDescriptors.size()),
+            writeDescriptors.data(),
+            0,
+            nullptr);
+
+        dirtyBindings.clear();
     }
 
     const RenderPassInputDeclaration* VulkanDescriptorManager::getRenderPassInputDeclaration(const std::string& name) const
@@ -209,7 +316,14 @@ namespace Astranox
             AST_CORE_ASSERT(false, "Render pass input {0} not found", name);
             return;
         }
-        m_RenderPassInputResources.at(declaration->set).at(declaration->binding).setInput(ub, 0);
+        RenderPassInput& input = m_RenderPassInputResources.at(declaration->set).at(declaration->binding);
+        if (input.type == RenderPassResourceType::UniformBuffer && input.input[0].raw() == ub.raw())
+        {
+            return;
+        }
+
+        input.setInput(ub, 0);
+        markDirty(declaration->set, declaration->binding);
     }
 
     void VulkanDescriptorManager::setInput(const std::string& name, Ref<UniformBufferArray> uba)
@@ -220,7 +334,14 @@ namespace Astranox
             AST_CORE_ASSERT(false, "Render pass input {0} not found", name);
             return;
         }
-        m_RenderPassInputResources.at(declaration->set).at(declaration->binding).setInput(uba, 0);
+        RenderPassInput& input = m_RenderPassInputResources.at(declaration->set).at(declaration->binding);
+        if (input.type == RenderPassResourceType::UniformBufferArray && input.input[0].raw() == uba.raw())
+        {
+            return;
+        }
+
+        input.setInput(uba, 0);
+        markDirty(declaration->set, declaration->binding);
     }
 
     void VulkanDescriptorManager::setInput(const std::string& name, Ref<Texture2D> texture, uint32_t index)
@@ -231,6 +352,49 @@ namespace Astranox
             AST_CORE_ASSERT(false, "Render pass input {0} not found", name);
             return;
         }
-        m_RenderPassInputResources.at(declaration->set).at(declaration->binding).setInput(texture, index);
+        RenderPassInput& input = m_RenderPassInputResources.at(declaration->set).at(declaration->binding);
+        if (input.input[index].raw() == texture.raw())
+        {
+            return;
+        }
+
+        input.setInput(texture, index);
+        markDirty(declaration->set, declaration->binding);
+    }
+
+    void VulkanDescriptorManager::setInput(const std::string& name, Ref<StorageBuffer> sb)
+    {
+        const RenderPassInputDeclaration* declaration = getRenderPassInputDeclaration(name);
+        if (!declaration)
+        {
+            AST_CORE_ASSERT(false, "Render pass input {0} not found", name);
+            return;
+        }
+        RenderPassInput& input = m_RenderPassInputResources.at(declaration->set).at(declaration->binding);
+        if (input.input[0].raw() == sb.raw())
+        {
+            return;
+        }
+
+        input.setInput(sb, 0);
+        markDirty(declaration->set, declaration->binding);
+    }
+
+    void VulkanDescriptorManager::setInput(const std::string& name, Ref<VulkanImage2D> image, uint32_t index)
+    {
+        const RenderPassInputDeclaration* declaration = getRenderPassInputDeclaration(name);
+        if (!declaration)
+        {
+            AST_CORE_ASSERT(false, "Render pass input {0} not found", name);
+            return;
+        }
+        RenderPassInput& input = m_RenderPassInputResources.at(declaration->set).at(declaration->binding);
+        if (input.input[index].raw() == image.raw())
+        {
+            return;
+        }
+
+        input.setInput(image, index);
+        markDirty(declaration->set, declaration->binding);
     }
 }
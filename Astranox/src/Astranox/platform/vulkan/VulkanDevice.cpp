@@ -6,13 +6,19 @@
 
 namespace Astranox
 {
-    static constexpr std::array<const char*, 1> s_DeviceExtensions = {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME
-    };
+    static std::vector<const char*> getDeviceExtensions(bool headless)
+    {
+        std::vector<const char*> deviceExtensions;
+        if (!headless)
+        {
+            deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+        return deviceExtensions;
+    }
 
-    static void checkDeviceExtensionSupport(Ref<VulkanPhysicalDevice> physicalDevice)
+    static void checkDeviceExtensionSupport(Ref<VulkanPhysicalDevice> physicalDevice, const std::vector<const char*>& deviceExtensions)
     {
-        for (const char* extensionName : s_DeviceExtensions)
+        for (const char* extensionName : deviceExtensions)
         {
             AST_CORE_ASSERT(
                 physicalDevice->isExtentionSupported(extensionName),
@@ -21,55 +27,80 @@ namespace Astranox
         }
     }
 
+    /**
+     * @brief Vulkan 1.2 features the engine relies on, checked against what the device supports.
+     */
+    static VkPhysicalDeviceVulkan12Features getRequiredVulkan12Features(Ref<VulkanPhysicalDevice> physicalDevice)
+    {
+        const auto& supported = physicalDevice->getVulkan12Features();
+
+        // Bindless textures (VulkanBindlessTextureRegistry)
+        AST_CORE_ASSERT(supported.descriptorIndexing, "Physical device does not support descriptor indexing!");
+        AST_CORE_ASSERT(supported.runtimeDescriptorArray, "Physical device does not support runtime descriptor arrays!");
+        AST_CORE_ASSERT(supported.descriptorBindingPartiallyBound, "Physical device does not support partially bound descriptors!");
+        AST_CORE_ASSERT(supported.descriptorBindingSampledImageUpdateAfterBind, "Physical device does not support updating sampled images after bind!");
+        AST_CORE_ASSERT(supported.descriptorBindingUpdateUnusedWhilePending, "Physical device does not support updating unused descriptors while pending!");
+        AST_CORE_ASSERT(supported.shaderSampledImageArrayNonUniformIndexing, "Physical device does not support non-uniform indexing of sampled images!");
+
+        // Cross-queue ordering against submitted frames (VulkanDevice::getFrameTimeline)
+        AST_CORE_ASSERT(supported.timelineSemaphore, "Physical device does not support timeline semaphores!");
+
+        return VkPhysicalDeviceVulkan12Features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+            .pNext = nullptr,
+            .descriptorIndexing = VK_TRUE,
+            .shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+            .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+            .descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+            .descriptorBindingPartiallyBound = VK_TRUE,
+            .runtimeDescriptorArray = VK_TRUE,
+            .timelineSemaphore = VK_TRUE,
+        };
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////
 
-    VulkanDevice::VulkanDevice(const Ref<VulkanPhysicalDevice>& physicalDevice)
+    VulkanDevice::VulkanDevice(const Ref<VulkanPhysicalDevice>& physicalDevice, bool headless)
         : m_PhysicalDevice(physicalDevice)
     {
-        checkDeviceExtensionSupport(m_PhysicalDevice);
+        std::vector<const char*> deviceExtensions = getDeviceExtensions(headless);
+        checkDeviceExtensionSupport(m_PhysicalDevice, deviceExtensions);
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
         float queuePriority = 1.0f;
         auto& queueFamilyIndices = m_PhysicalDevice->getQueueIndices();
 
-        VkDeviceQueueCreateInfo graphicsQueueCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .queueFamilyIndex = queueFamilyIndices.graphicsFamily.value(),
-            .queueCount = 1,
-            .pQueuePriorities = &queuePriority
+        // [NOTE] Graphics, compute and transfer may share a family (e.g. lavapipe exposes a single one),
+        // and each family may only be requested once.
+        std::set<uint32_t> uniqueQueueFamilies = {
+            queueFamilyIndices.graphicsFamily.value(),
+            queueFamilyIndices.computeFamily.value(),
+            queueFamilyIndices.transferFamily.value()
         };
-        queueCreateInfos.push_back(graphicsQueueCreateInfo);
 
-        VkDeviceQueueCreateInfo computeQueueCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .queueFamilyIndex = queueFamilyIndices.computeFamily.value(),
-            .queueCount = 1,
-            .pQueuePriorities = &queuePriority
-        };
-        queueCreateInfos.push_back(computeQueueCreateInfo);
+        for (uint32_t queueFamily : uniqueQueueFamilies)
+        {
+            VkDeviceQueueCreateInfo queueCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .queueFamilyIndex = queueFamily,
+                .queueCount = 1,
+                .pQueuePriorities = &queuePriority
+            };
+            queueCreateInfos.push_back(queueCreateInfo);
+        }
 
-        VkDeviceQueueCreateInfo transferQueueCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .queueFamilyIndex = queueFamilyIndices.transferFamily.value(),
-            .queueCount = 1,
-            .pQueuePriorities = &queuePriority
-        };
-        queueCreateInfos.push_back(transferQueueCreateInfo);
+        VkPhysicalDeviceVulkan12Features vulkan12Features = getRequiredVulkan12Features(m_PhysicalDevice);
 
         VkDeviceCreateInfo createInfo{
             .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-            .pNext = nullptr,
+            .pNext = &vulkan12Features,
             .flags = 0,
             .queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size()),
             .pQueueCreateInfos = queueCreateInfos.data(),
-            .enabledExtensionCount = static_cast<uint32_t>(s_DeviceExtensions.size()),
-            .ppEnabledExtensionNames = s_DeviceExtensions.data(),
+            .enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size()),
+            .ppEnabledExtensionNames = deviceExtensions.data(),
             .pEnabledFeatures = &m_PhysicalDevice->getFeatures()
         };
         if (VK_ENABLE_VALIDATION_LAYERS)
@@ -81,16 +112,58 @@ namespace Astranox
         VK_CHECK(::vkCreateDevice(m_PhysicalDevice->getRaw(), &createInfo, nullptr, &m_Device));
 
         ::vkGetDeviceQueue(m_Device, queueFamilyIndices.graphicsFamily.value(), 0, &m_GraphicsQueue);
+        ::vkGetDeviceQueue(m_Device, queueFamilyIndices.computeFamily.value(), 0, &m_ComputeQueue);
+        ::vkGetDeviceQueue(m_Device, queueFamilyIndices.transferFamily.value(), 0, &m_TransferQueue);
+
+        VkSemaphoreTypeCreateInfo timelineInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+            .initialValue = 0,
+        };
+        VkSemaphoreCreateInfo semaphoreInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = &timelineInfo,
+        };
+        VK_CHECK(::vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_FrameTimeline));
+
+        m_DescriptorAllocator = Ref<VulkanDescriptorAllocator>::create(m_Device);
+        m_PipelineCache = Ref<VulkanPipelineCache>::create(m_Device, m_PhysicalDevice->getProperties(), "assets/cache/pipeline/Vulkan/pipeline_cache.bin");
     }
 
     void VulkanDevice::destroy()
     {
         m_CommandPool = nullptr;
 
+        m_DescriptorAllocator->destroy();
+        m_DescriptorAllocator = nullptr;
+
+        m_PipelineCache->destroy();
+        m_PipelineCache = nullptr;
+
+        ::vkDestroySemaphore(m_Device, m_FrameTimeline, nullptr);
+        m_FrameTimeline = VK_NULL_HANDLE;
+
         ::vkDestroyDevice(m_Device, nullptr);
         m_Device = VK_NULL_HANDLE;
     }
 
+    bool VulkanDevice::hasDedicatedTransferQueue() const
+    {
+        auto& queueFamilyIndices = m_PhysicalDevice->getQueueIndices();
+        return queueFamilyIndices.transferFamily.value() != queueFamilyIndices.graphicsFamily.value();
+    }
+
+    std::vector<uint32_t> VulkanDevice::getUniqueQueueFamilies() const
+    {
+        auto& queueFamilyIndices = m_PhysicalDevice->getQueueIndices();
+        std::set<uint32_t> uniqueQueueFamilies = {
+            queueFamilyIndices.graphicsFamily.value(),
+            queueFamilyIndices.computeFamily.value(),
+            queueFamilyIndices.transferFamily.value()
+        };
+        return std::vector<uint32_t>(uniqueQueueFamilies.begin(), uniqueQueueFamilies.end());
+    }
+
     void VulkanDevice::waitIdle() const
     {
         ::vkDeviceWaitIdle(m_Device);
@@ -0,0 +1,147 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanImage2D.hpp"
+
+#include "Astranox/platform/vulkan/VulkanMemoryAllocator.hpp"
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    VulkanImage2D::VulkanImage2D(uint32_t width, uint32_t height, VkFormat format)
+        : m_Width(width), m_Height(height), m_Format(format)
+    {
+        auto device = VulkanContext::get()->getDevice();
+        VulkanMemoryAllocator allocator("VulkanImage2D");
+
+        // Image >>>
+        // [NOTE] Shared between the queue families, like storage buffers, so compute and graphics can use it without ownership transfers.
+        std::vector<uint32_t> queueFamilies = device->getUniqueQueueFamilies();
+        bool concurrent = queueFamilies.size() > 1;
+
+        VkImageCreateInfo imageInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .flags = 0,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = m_Format,
+            .extent = {
+                .width = m_Width,
+                .height = m_Height,
+                .depth = 1
+            },
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = VK_IMAGE_USAGE_STORAGE_BIT |
+                  VK_IMAGE_USAGE_SAMPLED_BIT |
+                  VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                  VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            .sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(queueFamilies.size()) : 0,
+            .pQueueFamilyIndices = concurrent ? queueFamilies.data() : nullptr,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+        m_ImageAllocation = allocator.createImage(
+            imageInfo,
+            VMA_MEMORY_USAGE_GPU_ONLY,
+            m_Image
+        );
+
+        m_UploadHandle = VulkanContext::get()->getUploadManager()->record([this](VkCommandBuffer commandBuffer) {
+            VkImageMemoryBarrier barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = 0,
+                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = m_Image,
+                .subresourceRange = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .baseMipLevel = 0,
+                    .levelCount = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1
+                }
+            };
+            ::vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+        });
+        // <<< Image
+
+        // Image view >>>
+        VkImageViewCreateInfo viewInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = m_Image,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = m_Format,
+            .components = {
+                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .a = VK_COMPONENT_SWIZZLE_IDENTITY
+            },
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            }
+        };
+        VK_CHECK(::vkCreateImageView(device->getRaw(), &viewInfo, nullptr, &m_ImageView));
+        // <<< Image view
+
+        // Sampler >>>
+        VkSamplerCreateInfo samplerInfo{
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_LINEAR,
+            .minFilter = VK_FILTER_LINEAR,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .mipLodBias = 0.0f,
+            .anisotropyEnable = VK_FALSE,
+            .maxAnisotropy = 1.0f,
+            .compareEnable = VK_FALSE,
+            .compareOp = VK_COMPARE_OP_ALWAYS,
+            .minLod = 0,
+            .maxLod = 0,
+            .borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
+            .unnormalizedCoordinates = VK_FALSE,
+        };
+        VK_CHECK(::vkCreateSampler(device->getRaw(), &samplerInfo, nullptr, &m_Sampler));
+        // <<< Sampler
+
+        m_DescriptorImageInfo = {
+            .sampler = m_Sampler,
+            .imageView = m_ImageView,
+            .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+        };
+    }
+
+    VulkanImage2D::~VulkanImage2D()
+    {
+        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
+
+        VulkanContext::get()->getDeletionQueue()->push(
+            [device, image = m_Image, allocation = m_ImageAllocation, imageView = m_ImageView, sampler = m_Sampler, uploadHandle = m_UploadHandle]() {
+                // The initial transition may still be pending.
+                VulkanContext::get()->getUploadManager()->wait(uploadHandle);
+
+                VulkanMemoryAllocator allocator("VulkanImage2D");
+                ::vkDestroySampler(device, sampler, nullptr);
+                ::vkDestroyImageView(device, imageView, nullptr);
+                allocator.destroyImage(image, allocation);
+            }
+        );
+    }
+}
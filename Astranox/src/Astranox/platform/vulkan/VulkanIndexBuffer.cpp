@@ -13,25 +13,6 @@ namespace Astranox
 
         VulkanMemoryAllocator allocator("VulkanIndexBuffer");
 
-        VkBufferCreateInfo stagingBufferCI{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = bytes,
-            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        };
-
-        VkBuffer stagingBuffer;
-        VmaAllocation stagingBufferAllocation = allocator.createBuffer(
-            stagingBufferCI,
-            VMA_MEMORY_USAGE_CPU_TO_GPU,
-            stagingBuffer
-        );
-
-        // Upload data to staging buffer
-        void* dest = allocator.mapMemory<void>(stagingBufferAllocation);
-        std::memcpy(dest, data, bytes);
-        allocator.unmapMemory(stagingBufferAllocation);
-
         VkBufferCreateInfo indexBufferCI{
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .size = bytes,
@@ -44,15 +25,20 @@ namespace Astranox
             VMA_MEMORY_USAGE_GPU_ONLY,
             m_IndexBuffer
         );
-        
-        allocator.copyBuffer(stagingBuffer, m_IndexBuffer, bytes);
 
-        allocator.destroyBuffer(stagingBuffer, stagingBufferAllocation);
+        m_UploadHandle = VulkanContext::get()->getUploadManager()->uploadBuffer(m_IndexBuffer, data, bytes);
     }
 
     VulkanIndexBuffer::~VulkanIndexBuffer()
     {
-        VulkanMemoryAllocator allocator("VulkanIndexBuffer");
-        allocator.destroyBuffer(m_IndexBuffer, m_IndexBufferAllocation);
+        VulkanContext::get()->getDeletionQueue()->push(
+            [buffer = m_IndexBuffer, allocation = m_IndexBufferAllocation, uploadHandle = m_UploadHandle]() {
+                // The copy into this buffer may still be pending.
+                VulkanContext::get()->getUploadManager()->wait(uploadHandle);
+
+                VulkanMemoryAllocator allocator("VulkanIndexBuffer");
+                allocator.destroyBuffer(buffer, allocation);
+            }
+        );
     }
 }
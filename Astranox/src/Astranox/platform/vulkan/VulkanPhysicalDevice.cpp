@@ -53,6 +53,28 @@ namespace Astranox
 
         m_Features.samplerAnisotropy = true;
 
+        // Get Vulkan 1.2 features and descriptor indexing limits >>>
+        m_Vulkan12Features = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+            .pNext = nullptr,
+        };
+        VkPhysicalDeviceFeatures2 features2{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &m_Vulkan12Features,
+        };
+        ::vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &features2);
+
+        m_DescriptorIndexingProperties = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+            .pNext = nullptr,
+        };
+        VkPhysicalDeviceProperties2 properties2{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &m_DescriptorIndexingProperties,
+        };
+        ::vkGetPhysicalDeviceProperties2(m_PhysicalDevice, &properties2);
+        // <<< Get Vulkan 1.2 features and descriptor indexing limits
+
         // Get queue family properties >>>
         uint32_t queueFamilyCount = 0;
         ::vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamilyCount, nullptr);
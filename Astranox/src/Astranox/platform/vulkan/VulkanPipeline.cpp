@@ -10,19 +10,164 @@
 
 namespace Astranox
 {
+    namespace Utils
+    {
+        template<typename T>
+        static void hashCombine(size_t& seed, const T& value)
+        {
+            seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        static void hashLayout(size_t& seed, const VertexBufferLayout& layout)
+        {
+            hashCombine(seed, layout.getStride());
+            hashCombine(seed, layout.getElements().size());
+            for (const auto& element : layout.getElements())
+            {
+                hashCombine(seed, static_cast<uint8_t>(element.dataType));
+                hashCombine(seed, element.offset);
+                hashCombine(seed, element.normalized);
+            }
+        }
+
+        static bool layoutsMatch(const VertexBufferLayout& a, const VertexBufferLayout& b)
+        {
+            if (a.getStride() != b.getStride() || a.getElements().size() != b.getElements().size())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < a.getElements().size(); i++)
+            {
+                const auto& ea = a.getElements()[i];
+                const auto& eb = b.getElements()[i];
+                if (ea.dataType != eb.dataType || ea.offset != eb.offset || ea.normalized != eb.normalized)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static VkPrimitiveTopology primitiveTopologyToVk(PrimitiveTopology topology)
+        {
+            switch (topology)
+            {
+                case PrimitiveTopology::TriangleList: { return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; }
+                case PrimitiveTopology::TriangleStrip: { return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP; }
+                case PrimitiveTopology::LineList: { return VK_PRIMITIVE_TOPOLOGY_LINE_LIST; }
+                case PrimitiveTopology::PointList: { return VK_PRIMITIVE_TOPOLOGY_POINT_LIST; }
+            }
+
+            AST_CORE_ASSERT(false, "Unknown primitive topology!");
+            return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        }
+
+        static VkCullModeFlags cullModeToVk(CullMode cullMode)
+        {
+            switch (cullMode)
+            {
+                case CullMode::None: { return VK_CULL_MODE_NONE; }
+                case CullMode::Front: { return VK_CULL_MODE_FRONT_BIT; }
+                case CullMode::Back: { return VK_CULL_MODE_BACK_BIT; }
+            }
+
+            AST_CORE_ASSERT(false, "Unknown cull mode!");
+            return VK_CULL_MODE_BACK_BIT;
+        }
+
+        /**
+         * @brief Fill in the swapchain's render pass and formats where the specification leaves them unset,
+         * so the key of a pipeline never depends on state outside of it.
+         */
+        static PipelineSpecification resolveRenderTarget(PipelineSpecification specification)
+        {
+            auto swapchain = VulkanContext::get()->getSwapchain();
+
+            if (specification.renderPass == VK_NULL_HANDLE)
+            {
+                specification.renderPass = swapchain->getRenderPass();
+            }
+            if (specification.colorFormat == VK_FORMAT_UNDEFINED)
+            {
+                specification.colorFormat = swapchain->getImageFormat();
+            }
+            if (specification.depthFormat == VK_FORMAT_UNDEFINED)
+            {
+                specification.depthFormat = VulkanContext::get()->getPhysicalDevice()->getDepthFormat();
+            }
+            return specification;
+        }
+    }
+
+    // PipelineSpecification >>>
+    size_t PipelineSpecification::hash() const
+    {
+        size_t seed = 0;
+        Utils::hashCombine(seed, static_cast<const void*>(shader.raw()));
+        Utils::hashLayout(seed, vertexBufferLayout);
+        Utils::hashLayout(seed, instanceBufferLayout);
+        Utils::hashCombine(seed, depthTestEnable);
+        Utils::hashCombine(seed, depthWriteEnable);
+        Utils::hashCombine(seed, static_cast<uint8_t>(variant.blendMode));
+        Utils::hashCombine(seed, static_cast<uint8_t>(variant.cullMode));
+        Utils::hashCombine(seed, static_cast<uint8_t>(variant.topology));
+        for (auto& [name, value] : specializationConstants)
+        {
+            Utils::hashCombine(seed, name);
+            Utils::hashCombine(seed, value);
+        }
+
+        Utils::hashCombine(seed, static_cast<const void*>(renderPass));
+        Utils::hashCombine(seed, static_cast<int>(colorFormat));
+        Utils::hashCombine(seed, static_cast<int>(depthFormat));
+        return seed;
+    }
+
+    bool PipelineSpecification::operator==(const PipelineSpecification& other) const
+    {
+        return shader.raw() == other.shader.raw()
+            && Utils::layoutsMatch(vertexBufferLayout, other.vertexBufferLayout)
+            && Utils::layoutsMatch(instanceBufferLayout, other.instanceBufferLayout)
+            && depthTestEnable == other.depthTestEnable
+            && depthWriteEnable == other.depthWriteEnable
+            && variant == other.variant
+            && specializationConstants == other.specializationConstants
+            && renderPass == other.renderPass
+            && colorFormat == other.colorFormat
+            && depthFormat == other.depthFormat;
+    }
+    // <<< PipelineSpecification
+
     VulkanPipeline::VulkanPipeline(const PipelineSpecification& specification)
-        : m_Specification(specification)
+        : m_Specification(Utils::resolveRenderTarget(specification))
     {
         init();
     }
 
     VulkanPipeline::~VulkanPipeline()
     {
-        auto device = VulkanContext::get()->getDevice();
+        release();
+    }
+
+    void VulkanPipeline::invalidate()
+    {
+        release();
+        init();
+    }
+
+    void VulkanPipeline::release()
+    {
+        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
 
-        ::vkDestroyPipeline(device->getRaw(), m_Pipeline, nullptr);
-        ::vkDestroyPipelineLayout(device->getRaw(), m_PipelineLayout, nullptr);
-        ::vkDestroyPipelineCache(device->getRaw(), m_PipelineCache, nullptr);
+        VulkanContext::get()->getDeletionQueue()->push(
+            [device, pipeline = m_Pipeline, pipelineLayout = m_PipelineLayout]() {
+                ::vkDestroyPipeline(device, pipeline, nullptr);
+                ::vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+            }
+        );
+        m_Pipeline = VK_NULL_HANDLE;
+        m_PipelineLayout = VK_NULL_HANDLE;
     }
 
     void VulkanPipeline::init()
@@ -30,6 +175,7 @@ namespace Astranox
         auto device = VulkanContext::get()->getDevice();
 
         Ref<VulkanShader> shader = m_Specification.shader.as<VulkanShader>();
+        // Reflected from the shader, including the bindless texture table if the shader samples it.
         const auto& descriptorSetLayouts = shader->getDescriptorSetLayouts();
         const auto& pushConstantRanges = shader->getPushConstantRanges();
 
@@ -47,28 +193,52 @@ namespace Astranox
 
         // Pipeline >>>
         // (1) Vertex Input
-        auto& vbLayout = m_Specification.vertexBufferLayout;
-        std::vector<VkVertexInputBindingDescription> vertexInputBindings{
-            {
-                .binding = 0,
-                .stride = vbLayout.getStride(),
-                .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
-            }
-        };
+        // [NOTE] Per-vertex data comes first and per-instance data follows, both in bindings and in locations.
+        //      A pipeline without per-vertex data (e.g. vertices generated from gl_VertexIndex) starts at binding 0.
+        //      Elements are matched with the reflected shader inputs in location order, so locations may have gaps.
+        const auto& vertexInputs = shader->getVertexInputs();
+        AST_CORE_ASSERT(
+            vertexInputs.size() == m_Specification.vertexBufferLayout.getElements().size() + m_Specification.instanceBufferLayout.getElements().size(),
+            "Vertex layout of the pipeline does not match the inputs of shader {0}!", shader->getName());
 
+        std::vector<VkVertexInputBindingDescription> vertexInputBindings;
         std::vector<VkVertexInputAttributeDescription> vertexInputAttributes;
-        auto& elements = vbLayout.getElements();
-        for (uint32_t i = 0; i < static_cast<uint32_t>(elements.size()); i++)
+
+        auto addVertexInput = [&](const VertexBufferLayout& layout, VkVertexInputRate inputRate)
         {
-            const auto& e = elements[i];
-            VkVertexInputAttributeDescription attribute = {
-                .location = i,
-                .binding = 0,
-                .format = VulkanUtils::shaderDataTypeToVkFormat(e.dataType),
-                .offset = e.offset
-            };
-            vertexInputAttributes.push_back(attribute);
-        }
+            if (layout.getElements().empty())
+            {
+                return;
+            }
+
+            uint32_t binding = static_cast<uint32_t>(vertexInputBindings.size());
+            vertexInputBindings.push_back({
+                .binding = binding,
+                .stride = layout.getStride(),
+                .inputRate = inputRate,
+            });
+
+            for (const auto& e : layout.getElements())
+            {
+                const VertexInputInfo& input = vertexInputs[vertexInputAttributes.size()];
+
+                VkFormat format = VulkanUtils::shaderDataTypeToVkFormat(e.dataType);
+                if (format != input.format)
+                {
+                    AST_CORE_WARN("Vertex element {0} does not match the type of shader input {1} (location {2}).", e.name, input.name, input.location);
+                }
+
+                VkVertexInputAttributeDescription attribute = {
+                    .location = input.location,
+                    .binding = binding,
+                    .format = format,
+                    .offset = e.offset
+                };
+                vertexInputAttributes.push_back(attribute);
+            }
+        };
+        addVertexInput(m_Specification.vertexBufferLayout, VK_VERTEX_INPUT_RATE_VERTEX);
+        addVertexInput(m_Specification.instanceBufferLayout, VK_VERTEX_INPUT_RATE_INSTANCE);
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
@@ -79,7 +249,7 @@ namespace Astranox
         };
 
         // (2) Input Assembly
-        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkPrimitiveTopology topology = Utils::primitiveTopologyToVk(m_Specification.variant.topology);
         VkBool32 primitiveRestartEnable = VK_FALSE;
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
@@ -91,8 +261,6 @@ namespace Astranox
         // We don't use it for now
 
         // (4) Viewport and Scissor
-        auto swapchain = VulkanContext::get()->getSwapchain();
-
         VkPipelineViewportStateCreateInfo viewportStateInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
             .viewportCount = 1,
@@ -101,7 +269,7 @@ namespace Astranox
 
         // (5) Rasterization
         VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
-        VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+        VkCullModeFlags cullMode = Utils::cullModeToVk(m_Specification.variant.cullMode);
         float lineWidth = 1.0f;
         VkPipelineRasterizationStateCreateInfo rasterizationInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
@@ -142,10 +310,11 @@ namespace Astranox
         };
 
         // (8) Color Blending
+        BlendMode blendMode = m_Specification.variant.blendMode;
         VkPipelineColorBlendAttachmentState colorBlendAttachment = {
-            .blendEnable = VK_TRUE,
+            .blendEnable = blendMode != BlendMode::None ? VK_TRUE : VK_FALSE,
             .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
-            .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+            .dstColorBlendFactor = blendMode == BlendMode::Additive ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
             .colorBlendOp = VK_BLEND_OP_ADD,
             .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
             .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
@@ -174,7 +343,40 @@ namespace Astranox
             .pDynamicStates = dynamicStates.data(),
         };
 
-        auto& shaderStages = shader->getShaderStageCreateInfos();
+        // (10) Specialization
+        // [NOTE] Every constant is one 32-bit word. A single VkSpecializationInfo is shared by all stages,
+        //      entries whose constant a stage does not declare are ignored by that stage.
+        std::vector<VkSpecializationMapEntry> specializationEntries;
+        std::vector<uint32_t> specializationData;
+        for (auto& [name, value] : m_Specification.specializationConstants)
+        {
+            const SpecializationConstantInfo* constant = shader->findSpecializationConstant(name);
+            AST_CORE_ASSERT(constant, "Shader {0} has no specialization constant {1}!", shader->getName(), name);
+
+            specializationEntries.push_back({
+                .constantID = constant->constantID,
+                .offset = static_cast<uint32_t>(specializationData.size() * sizeof(uint32_t)),
+                .size = sizeof(uint32_t),
+            });
+            specializationData.push_back(value);
+        }
+
+        VkSpecializationInfo specializationInfo = {
+            .mapEntryCount = static_cast<uint32_t>(specializationEntries.size()),
+            .pMapEntries = specializationEntries.data(),
+            .dataSize = specializationData.size() * sizeof(uint32_t),
+            .pData = specializationData.data(),
+        };
+
+        // Copied, since the create infos of the shader are shared by all of its pipelines.
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages = shader->getShaderStageCreateInfos();
+        if (!specializationEntries.empty())
+        {
+            for (auto& shaderStage : shaderStages)
+            {
+                shaderStage.pSpecializationInfo = &specializationInfo;
+            }
+        }
 
         VkGraphicsPipelineCreateInfo pipelineInfo = {
             .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
@@ -190,26 +392,158 @@ namespace Astranox
             .pColorBlendState = &colorBlendingInfo,
             .pDynamicState = &dynamicStateInfo,
             .layout = m_PipelineLayout,
-            .renderPass = swapchain->getRenderPass(),
+            .renderPass = m_Specification.renderPass,
             .subpass = 0,
             .basePipelineHandle = VK_NULL_HANDLE,
             .basePipelineIndex = -1,
         };
 
-        VK_CHECK(::vkCreateGraphicsPipelines(device->getRaw(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline));
+        m_Pipeline = device->getPipelineCache()->createGraphicsPipeline(pipelineInfo);
         // <<< Pipeline
+    }
 
+    // PipelineLibrary >>>
+    Ref<VulkanPipeline> PipelineLibrary::get(const PipelineSpecification& requestedSpecification)
+    {
+        PipelineSpecification specification = Utils::resolveRenderTarget(requestedSpecification);
 
-        // Pipeline Cache >>>
-        VkPipelineCacheCreateInfo pipelineCacheInfo = {
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .initialDataSize = 0,
-            .pInitialData = nullptr,
-        };
+        std::promise<Ref<VulkanPipeline>> promise;
+        Ref<PipelineHandle> pending = nullptr;
+        {
+            std::scoped_lock lock(m_Mutex);
+
+            auto it = m_Pipelines.find(specification);
+            if (it != m_Pipelines.end())
+            {
+                return it->second;
+            }
+
+            auto pendingIt = m_PendingPipelines.find(specification);
+            if (pendingIt != m_PendingPipelines.end())
+            {
+                // [NOTE] Wait outside the lock, since the builder takes it to publish the pipeline.
+                pending = pendingIt->second;
+            }
+            else
+            {
+                // Reserve the specification, so concurrent requests wait for this build instead of starting their own.
+                m_PendingPipelines.emplace(specification, Ref<PipelineHandle>::create(promise.get_future().share()));
+            }
+        }
+
+        if (pending)
+        {
+            return pending->wait();
+        }
+
+        // [NOTE] Built outside the lock, so other lookups and finished background builds are not held up.
+        Ref<VulkanPipeline> pipeline = Ref<VulkanPipeline>::create(specification);
+        publish(specification, pipeline);
+        promise.set_value(pipeline);
+        return pipeline;
+    }
+
+    Ref<PipelineHandle> PipelineLibrary::getAsync(const PipelineSpecification& requestedSpecification)
+    {
+        PipelineSpecification specification = Utils::resolveRenderTarget(requestedSpecification);
+
+        std::scoped_lock lock(m_Mutex);
+
+        auto it = m_Pipelines.find(specification);
+        if (it != m_Pipelines.end())
+        {
+            std::promise<Ref<VulkanPipeline>> ready;
+            ready.set_value(it->second);
+            return Ref<PipelineHandle>::create(ready.get_future().share());
+        }
+
+        auto pendingIt = m_PendingPipelines.find(specification);
+        if (pendingIt != m_PendingPipelines.end())
+        {
+            return pendingIt->second;
+        }
+
+        std::shared_future<Ref<VulkanPipeline>> future = Renderer::getThreadPool().submit(
+            [this, specification]() {
+                Ref<VulkanPipeline> pipeline = Ref<VulkanPipeline>::create(specification);
+                publish(specification, pipeline);
+                return pipeline;
+            }
+        ).share();
+
+        Ref<PipelineHandle> handle = Ref<PipelineHandle>::create(future);
+        m_PendingPipelines.emplace(specification, handle);
+        return handle;
+    }
+
+    Ref<VulkanPipeline> PipelineLibrary::getVariant(const Ref<VulkanPipeline>& base, const PipelineVariant& variant)
+    {
+        PipelineSpecification specification = base->getSpecification();
+        specification.variant = variant;
+        return get(specification);
+    }
+
+    void PipelineLibrary::waitPending(const Ref<Shader>& shader)
+    {
+        std::vector<Ref<PipelineHandle>> pending;
+        {
+            std::scoped_lock lock(m_Mutex);
+            for (auto& [specification, handle] : m_PendingPipelines)
+            {
+                if (specification.shader.raw() == shader.raw())
+                {
+                    pending.push_back(handle);
+                }
+            }
+        }
+
+        // [NOTE] Wait outside the lock, since the builders take it to publish the pipelines.
+        for (auto& handle : pending)
+        {
+            handle->wait();
+        }
+    }
+
+    uint32_t PipelineLibrary::invalidate(const Ref<Shader>& shader)
+    {
+        // Pipelines still compiling would be built from the previous shader.
+        waitPending(shader);
+
+        std::scoped_lock lock(m_Mutex);
+
+        uint32_t count = 0;
+        for (auto& [specification, pipeline] : m_Pipelines)
+        {
+            if (specification.shader.raw() == shader.raw())
+            {
+                pipeline->invalidate();
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void PipelineLibrary::clear()
+    {
+        // Pipelines still compiling in the background would be published after the clear.
+        Renderer::getThreadPool().waitIdle();
+
+        std::scoped_lock lock(m_Mutex);
+        m_Pipelines.clear();
+        m_PendingPipelines.clear();
+    }
 
-        VK_CHECK(::vkCreatePipelineCache(device->getRaw(), &pipelineCacheInfo, nullptr, &m_PipelineCache));
-        // <<< Pipeline Cache
+    void PipelineLibrary::publish(const PipelineSpecification& specification, const Ref<VulkanPipeline>& pipeline)
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Pipelines.emplace(specification, pipeline);
+        m_PendingPipelines.erase(specification);
+    }
+
+    size_t PipelineLibrary::getSize() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_Pipelines.size();
     }
+    // <<< PipelineLibrary
 }
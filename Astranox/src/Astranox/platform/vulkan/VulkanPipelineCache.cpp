@@ -0,0 +1,174 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanPipelineCache.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    VulkanPipelineCache::VulkanPipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& filepath)
+        : m_Device(device), m_Properties(properties), m_Filepath(filepath)
+    {
+        std::vector<uint8_t> initialData = loadInitialData();
+
+        VkPipelineCacheCreateInfo pipelineCacheInfo = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .initialDataSize = initialData.size(),
+            .pInitialData = initialData.empty() ? nullptr : initialData.data(),
+        };
+        VK_CHECK(::vkCreatePipelineCache(m_Device, &pipelineCacheInfo, nullptr, &m_PipelineCache));
+    }
+
+    void VulkanPipelineCache::destroy()
+    {
+        save();
+
+        Statistics stats = getStats();
+        AST_CORE_INFO("Pipeline cache: {0} pipelines created in {1:.2f}ms, {2} hits, {3} misses",
+            stats.pipelineCount, stats.creationMilliseconds, stats.hitCount, stats.missCount);
+
+        ::vkDestroyPipelineCache(m_Device, m_PipelineCache, nullptr);
+        m_PipelineCache = VK_NULL_HANDLE;
+    }
+
+    VkPipeline VulkanPipelineCache::createGraphicsPipeline(const VkGraphicsPipelineCreateInfo& createInfo)
+    {
+        VkPipelineCreationFeedback pipelineFeedback{};
+        VkPipelineCreationFeedbackCreateInfo feedbackInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+            .pNext = createInfo.pNext,
+            .pPipelineCreationFeedback = &pipelineFeedback,
+            .pipelineStageCreationFeedbackCount = 0,
+            .pPipelineStageCreationFeedbacks = nullptr,
+        };
+
+        VkGraphicsPipelineCreateInfo pipelineInfo = createInfo;
+        pipelineInfo.pNext = &feedbackInfo;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VK_CHECK(::vkCreateGraphicsPipelines(m_Device, m_PipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
+
+        recordFeedback(pipelineFeedback);
+        return pipeline;
+    }
+
+    VkPipeline VulkanPipelineCache::createComputePipeline(const VkComputePipelineCreateInfo& createInfo)
+    {
+        VkPipelineCreationFeedback pipelineFeedback{};
+        VkPipelineCreationFeedbackCreateInfo feedbackInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+            .pNext = createInfo.pNext,
+            .pPipelineCreationFeedback = &pipelineFeedback,
+            .pipelineStageCreationFeedbackCount = 0,
+            .pPipelineStageCreationFeedbacks = nullptr,
+        };
+
+        VkComputePipelineCreateInfo pipelineInfo = createInfo;
+        pipelineInfo.pNext = &feedbackInfo;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VK_CHECK(::vkCreateComputePipelines(m_Device, m_PipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
+
+        recordFeedback(pipelineFeedback);
+        return pipeline;
+    }
+
+    void VulkanPipelineCache::save()
+    {
+        size_t dataSize = 0;
+        VK_CHECK(::vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, nullptr));
+
+        std::vector<uint8_t> data(dataSize);
+        VK_CHECK(::vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, data.data()));
+        data.resize(dataSize);
+
+        std::filesystem::create_directories(m_Filepath.parent_path());
+
+        // [NOTE] Write to a temporary file first, so a crash never leaves a truncated cache behind.
+        std::filesystem::path tempFilepath = m_Filepath;
+        tempFilepath += ".tmp";
+        {
+            std::ofstream out(tempFilepath, std::ios::out | std::ios::binary);
+            if (!out.is_open())
+            {
+                AST_CORE_WARN("Failed to write pipeline cache: {0}", tempFilepath.string());
+                return;
+            }
+            out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempFilepath, m_Filepath, error);
+        if (error)
+        {
+            AST_CORE_WARN("Failed to write pipeline cache: {0} ({1})", m_Filepath.string(), error.message());
+            return;
+        }
+
+        AST_CORE_DEBUG("Saved pipeline cache ({0} bytes): {1}", data.size(), m_Filepath.string());
+    }
+
+    VulkanPipelineCache::Statistics VulkanPipelineCache::getStats() const
+    {
+        std::scoped_lock lock(m_StatsMutex);
+        return m_Stats;
+    }
+
+    std::vector<uint8_t> VulkanPipelineCache::loadInitialData()
+    {
+        std::ifstream in(m_Filepath, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+        {
+            AST_CORE_DEBUG("No pipeline cache found at {0}, starting cold.", m_Filepath.string());
+            return {};
+        }
+
+        std::vector<uint8_t> data(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char*>(data.data()), data.size());
+
+        // [NOTE] Drivers are supposed to reject foreign data themselves, but not all of them do so gracefully.
+        VkPipelineCacheHeaderVersionOne header{};
+        if (data.size() < sizeof(header))
+        {
+            AST_CORE_WARN("Pipeline cache is truncated, discarding it.");
+            return {};
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        bool valid = header.headerSize >= sizeof(header)
+            && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+            && header.vendorID == m_Properties.vendorID
+            && header.deviceID == m_Properties.deviceID
+            && std::memcmp(header.pipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        if (!valid)
+        {
+            AST_CORE_WARN("Pipeline cache was written by another device or driver, discarding it.");
+            return {};
+        }
+
+        AST_CORE_DEBUG("Loaded pipeline cache ({0} bytes): {1}", data.size(), m_Filepath.string());
+        return data;
+    }
+
+    void VulkanPipelineCache::recordFeedback(const VkPipelineCreationFeedback& feedback)
+    {
+        std::scoped_lock lock(m_StatsMutex);
+
+        m_Stats.pipelineCount++;
+        if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT))
+        {
+            return;
+        }
+
+        if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT)
+        {
+            m_Stats.hitCount++;
+        }
+        else
+        {
+            m_Stats.missCount++;
+        }
+        m_Stats.creationMilliseconds += feedback.duration / 1.0e6;
+    }
+}
@@ -72,7 +72,11 @@ namespace Astranox
         };
         vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+        // [NOTE] The sets of a descriptor manager cover every set of the pipeline layout, the bindless texture table included.
+        if (!descriptorSets.empty())
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+        }
 
         // Bind pipeline
         VkPipeline graphicsPipeline = pipeline->getRaw();
@@ -112,13 +116,102 @@ namespace Astranox
         VkBuffer ib = indexBuffer.as<VulkanIndexBuffer>()->getRaw();
         vkCmdBindIndexBuffer(commandBuffer, ib, 0, VK_INDEX_TYPE_UINT32);
 
-        //VkDescriptorSet descriptorSet = dm->getDescriptorSets(frameIndex)[0];
-        //if (descriptorSet != VK_NULL_HANDLE)
-        //{
-        //    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(), 0, 1, &descriptorSet, 0, nullptr);
-        //}
+        // [NOTE] Consecutive draws in the same render pass may use different descriptor sets (e.g. Renderer2D batches).
+        const auto& descriptorSets = dm->getDescriptorSets(frameIndex);
+        if (!descriptorSets.empty())
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+        }
 
         vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
     }
-}
 
+    void VulkanRenderer::renderInstanced(
+        VkCommandBuffer commandBuffer,
+        Ref<VulkanPipeline> pipeline,
+        Ref<VulkanDescriptorManager> dm,
+        Ref<VertexBuffer> vertexBuffer,
+        Ref<VertexBuffer> instanceBuffer,
+        Ref<IndexBuffer> indexBuffer,
+        uint32_t indexCount,
+        uint32_t instanceCount
+    )
+    {
+        uint32_t frameIndex = Renderer::getCurrentFrameIndex();
+
+        // Bindings follow the order of VulkanPipeline: per-vertex data first, then per-instance data.
+        std::vector<VkBuffer> vbs;
+        if (vertexBuffer)
+        {
+            vbs.push_back(vertexBuffer.as<VulkanVertexBuffer>()->getRaw());
+        }
+        vbs.push_back(instanceBuffer.as<VulkanVertexBuffer>()->getRaw());
+
+        std::vector<VkDeviceSize> offsets(vbs.size(), 0);
+        vkCmdBindVertexBuffers(commandBuffer, 0, static_cast<uint32_t>(vbs.size()), vbs.data(), offsets.data());
+
+        VkBuffer ib = indexBuffer.as<VulkanIndexBuffer>()->getRaw();
+        vkCmdBindIndexBuffer(commandBuffer, ib, 0, VK_INDEX_TYPE_UINT32);
+
+        const auto& descriptorSets = dm->getDescriptorSets(frameIndex);
+        if (!descriptorSets.empty())
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+        }
+
+        vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, 0, 0, 0);
+    }
+
+    void VulkanRenderer::pushConstants(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline, const void* data, uint32_t size, uint32_t offset)
+    {
+        // Every stage whose range overlaps the update has to be named.
+        VkShaderStageFlags stageFlags = 0;
+        for (const auto& range : pipeline->getSpecification().shader.as<VulkanShader>()->getPushConstantRanges())
+        {
+            if (offset < range.offset + range.size && range.offset < offset + size)
+            {
+                stageFlags |= range.stageFlags;
+            }
+        }
+        AST_CORE_ASSERT(stageFlags, "No push constant range covers bytes [{0}, {1})!", offset, offset + size);
+
+        ::vkCmdPushConstants(commandBuffer, pipeline->getLayout(), stageFlags, offset, size, data);
+    }
+
+    void VulkanRenderer::dispatchCompute(
+        Ref<VulkanComputePipeline> pipeline,
+        Ref<VulkanDescriptorManager> dm,
+        uint32_t groupCountX,
+        uint32_t groupCountY,
+        uint32_t groupCountZ
+    )
+    {
+        uint32_t frameIndex = Renderer::getCurrentFrameIndex();
+        VkCommandBuffer commandBuffer = VulkanContext::get()->getSwapchain()->getCurrentComputeCommandBuffer();
+
+        ::vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->getRaw());
+
+        const auto& descriptorSets = dm->getDescriptorSets(frameIndex);
+        if (!descriptorSets.empty())
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->getLayout(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+        }
+
+        ::vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+
+        // Later dispatches of the frame may consume what this one wrote (e.g. culling after simulation).
+        VkMemoryBarrier barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        };
+        ::vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr
+        );
+    }
+}
@@ -1,6 +1,7 @@
 #include "pch.hpp"
 #include "Astranox/platform/vulkan/VulkanContext.hpp"
 #include "Astranox/platform/vulkan/VulkanShader.hpp"
+#include "Astranox/platform/vulkan/VulkanBindlessTextureRegistry.hpp"
 #include "Astranox/platform/vulkan/VulkanUtils.hpp"
 
 namespace Astranox
@@ -20,17 +21,65 @@ namespace Astranox
 
     void VulkanShader::destroy()
     {
-        auto device = VulkanContext::get()->getDevice();
+        VkDevice device = VulkanContext::get()->getDevice()->getRaw();
 
-        for (auto layout : m_DescriptorSetLayouts)
+        // The layout of the bindless texture table belongs to the registry.
+        std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
+        for (uint32_t setIndex = 0; setIndex < m_DescriptorSetLayouts.size(); ++setIndex)
         {
-            ::vkDestroyDescriptorSetLayout(device->getRaw(), layout, nullptr);
+            if (!isBindlessTextureSet(setIndex))
+            {
+                descriptorSetLayouts.push_back(m_DescriptorSetLayouts[setIndex]);
+            }
         }
 
-        for (auto stage : m_ShaderStages)
+        VulkanContext::get()->getDeletionQueue()->push(
+            [device, descriptorSetLayouts = std::move(descriptorSetLayouts), shaderStages = m_ShaderStages]() {
+                for (auto layout : descriptorSetLayouts)
+                {
+                    ::vkDestroyDescriptorSetLayout(device, layout, nullptr);
+                }
+
+                for (auto stage : shaderStages)
+                {
+                    ::vkDestroyShaderModule(device, stage.module, nullptr);
+                }
+            }
+        );
+        m_DescriptorSetLayouts.clear();
+        m_ShaderStages.clear();
+    }
+
+    bool VulkanShader::reload(Ref<VulkanShader> recompiled)
+    {
+        const ShaderReflectionData& current = m_ReflectionData;
+        const ShaderReflectionData& updated = recompiled->m_ReflectionData;
+
+        bool compatible = current.descriptorSets.size() == updated.descriptorSets.size()
+            && current.pushConstants == updated.pushConstants
+            && current.vertexInputs == updated.vertexInputs
+            && current.specializationConstants == updated.specializationConstants
+            && current.usesBindlessTextures == updated.usesBindlessTextures;
+        for (size_t set = 0; compatible && set < current.descriptorSets.size(); ++set)
         {
-            ::vkDestroyShaderModule(device->getRaw(), stage.module, nullptr);
+            const ShaderDescriptorSetInfo& a = current.descriptorSets[set];
+            const ShaderDescriptorSetInfo& b = updated.descriptorSets[set];
+            compatible = a.uniformBufferInfos == b.uniformBufferInfos
+                && a.imageSamplerInfos == b.imageSamplerInfos
+                && a.storageBufferInfos == b.storageBufferInfos
+                && a.storageImageInfos == b.storageImageInfos;
         }
+
+        if (!compatible)
+        {
+            AST_CORE_WARN("The interface of shader {0} changed, restart to apply the change.", m_Name);
+            return false;
+        }
+
+        // [NOTE] Only the stages are exchanged, `recompiled` retires the old ones along with its own layouts.
+        std::swap(m_ShaderStages, recompiled->m_ShaderStages);
+        m_Dependencies = recompiled->m_Dependencies;
+        return true;
     }
 
     void VulkanShader::createShaders(const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData)
@@ -61,16 +110,45 @@ namespace Astranox
         }
     }
 
+    const SpecializationConstantInfo* VulkanShader::findSpecializationConstant(const std::string& name) const
+    {
+        const auto& constants = m_ReflectionData.specializationConstants;
+        auto it = std::find_if(constants.begin(), constants.end(),
+            [&name](const SpecializationConstantInfo& info) { return info.name == name; });
+        return it == constants.end() ? nullptr : &*it;
+    }
+
+    bool VulkanShader::isBindlessTextureSet(uint32_t setIndex) const
+    {
+        return m_ReflectionData.usesBindlessTextures && setIndex == VulkanBindlessTextureRegistry::s_SetIndex;
+    }
+
     void VulkanShader::createDescriptorSetLayouts()
     {
-        uint32_t setCount = 1;
+        if (m_ReflectionData.usesBindlessTextures && m_ReflectionData.descriptorSets.size() <= VulkanBindlessTextureRegistry::s_SetIndex)
+        {
+            m_ReflectionData.descriptorSets.resize(VulkanBindlessTextureRegistry::s_SetIndex + 1);
+        }
+
+        // [NOTE] Sets between the used ones get an empty layout, since a pipeline layout cannot have holes.
+        uint32_t setCount = static_cast<uint32_t>(m_ReflectionData.descriptorSets.size());
         m_DescriptorSetLayouts.clear();
         m_DescriptorSetLayouts.resize(setCount);
+        m_DescriptorPoolSizes.clear();
+        m_DescriptorPoolSizes.resize(setCount);
 
         for (uint32_t setIndex = 0; setIndex < setCount; ++setIndex)
         {
+            if (isBindlessTextureSet(setIndex))
+            {
+                m_DescriptorSetLayouts[setIndex] = VulkanContext::get()->getBindlessTextureRegistry()->getDescriptorSetLayout();
+                continue;
+            }
+
+            ShaderDescriptorSetInfo& setInfo = m_ReflectionData.descriptorSets[setIndex];
+
             std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
-            for (auto& [binding, uniformBuffer] : m_ShaderDescriptorSetInfo.uniformBufferInfos)
+            for (auto& [binding, uniformBuffer] : setInfo.uniformBufferInfos)
             {
                 VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 
@@ -83,7 +161,7 @@ namespace Astranox
                     .pImmutableSamplers = nullptr,
                 };
 
-                VkWriteDescriptorSet& writeDescriptorSet = m_ShaderDescriptorSetInfo.writeDescriptorSets[uniformBuffer.name];
+                VkWriteDescriptorSet& writeDescriptorSet = setInfo.writeDescriptorSets[uniformBuffer.name];
                 writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                 writeDescriptorSet.dstBinding = binding;
                 writeDescriptorSet.dstArrayElement = 0;
@@ -93,7 +171,7 @@ namespace Astranox
                 writeDescriptorSet.pTexelBufferView = nullptr;
             }
 
-            for (auto& [binding, imageSampler] : m_ShaderDescriptorSetInfo.imageSamplerInfos)
+            for (auto& [binding, imageSampler] : setInfo.imageSamplerInfos)
             {
                 VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
@@ -106,7 +184,7 @@ namespace Astranox
                     .pImmutableSamplers = nullptr,
                 };
 
-                VkWriteDescriptorSet& writeDescriptorSet = m_ShaderDescriptorSetInfo.writeDescriptorSets[imageSampler.name];
+                VkWriteDescriptorSet& writeDescriptorSet = setInfo.writeDescriptorSets[imageSampler.name];
                 writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                 writeDescriptorSet.dstBinding = binding;
                 writeDescriptorSet.dstArrayElement = 0;
@@ -116,6 +194,67 @@ namespace Astranox
                 writeDescriptorSet.pTexelBufferView = nullptr;
             }
 
+            for (auto& [binding, storageBuffer] : setInfo.storageBufferInfos)
+            {
+                VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+                VkDescriptorSetLayoutBinding& bindingInfo = layoutBindings.emplace_back();
+                bindingInfo = {
+                    .binding = binding,
+                    .descriptorType = descriptorType,
+                    .descriptorCount = 1,
+                    .stageFlags = storageBuffer.shaderStage,
+                    .pImmutableSamplers = nullptr,
+                };
+
+                VkWriteDescriptorSet& writeDescriptorSet = setInfo.writeDescriptorSets[storageBuffer.name];
+                writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeDescriptorSet.dstBinding = binding;
+                writeDescriptorSet.dstArrayElement = 0;
+                writeDescriptorSet.descriptorCount = 1;
+                writeDescriptorSet.descriptorType = descriptorType;
+                writeDescriptorSet.pImageInfo = nullptr;
+                writeDescriptorSet.pTexelBufferView = nullptr;
+            }
+
+            for (auto& [binding, storageImage] : setInfo.storageImageInfos)
+            {
+                VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+                VkDescriptorSetLayoutBinding& bindingInfo = layoutBindings.emplace_back();
+                bindingInfo = {
+                    .binding = binding,
+                    .descriptorType = descriptorType,
+                    .descriptorCount = storageImage.arraySize,
+                    .stageFlags = storageImage.shaderStage,
+                    .pImmutableSamplers = nullptr,
+                };
+
+                VkWriteDescriptorSet& writeDescriptorSet = setInfo.writeDescriptorSets[storageImage.name];
+                writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeDescriptorSet.dstBinding = binding;
+                writeDescriptorSet.dstArrayElement = 0;
+                writeDescriptorSet.descriptorCount = storageImage.arraySize;
+                writeDescriptorSet.descriptorType = descriptorType;
+                writeDescriptorSet.pImageInfo = nullptr;
+                writeDescriptorSet.pTexelBufferView = nullptr;
+            }
+
+            auto& poolSizes = m_DescriptorPoolSizes[setIndex];
+            for (const VkDescriptorSetLayoutBinding& bindingInfo : layoutBindings)
+            {
+                auto it = std::find_if(poolSizes.begin(), poolSizes.end(),
+                    [&bindingInfo](const VkDescriptorPoolSize& poolSize) { return poolSize.type == bindingInfo.descriptorType; });
+                if (it == poolSizes.end())
+                {
+                    poolSizes.push_back({ bindingInfo.descriptorType, bindingInfo.descriptorCount });
+                }
+                else
+                {
+                    it->descriptorCount += bindingInfo.descriptorCount;
+                }
+            }
+
             VkDescriptorSetLayoutCreateInfo layoutInfo{
                 .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
                 .bindingCount = static_cast<uint32_t>(layoutBindings.size()),
@@ -129,4 +268,18 @@ namespace Astranox
                 &m_DescriptorSetLayouts[setIndex]));
         }
     }
+
+    void VulkanShader::createPushConstantRanges()
+    {
+        m_PushConstantRanges.clear();
+
+        for (const auto& pushConstant : m_ReflectionData.pushConstants)
+        {
+            m_PushConstantRanges.push_back({
+                .stageFlags = pushConstant.shaderStage,
+                .offset = pushConstant.offset,
+                .size = pushConstant.size,
+            });
+        }
+    }
 }
@@ -0,0 +1,257 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanShaderCache.hpp"
+
+namespace Astranox
+{
+    namespace Utils
+    {
+        static constexpr uint32_t s_SpirvMagicNumber = 0x07230203;
+
+        static std::string hashToString(uint64_t hash)
+        {
+            return std::format("{:016x}", hash);
+        }
+
+        /**
+         * @brief Write `size` bytes to `filepath` through a temporary file, so readers never see a partial file.
+         */
+        static bool writeFileAtomically(const std::filesystem::path& filepath, const void* data, size_t size)
+        {
+            std::filesystem::path tempFilepath = filepath;
+            tempFilepath += ".tmp";
+            {
+                std::ofstream out(tempFilepath, std::ios::out | std::ios::binary);
+                if (!out.is_open())
+                {
+                    return false;
+                }
+                out.write(reinterpret_cast<const char*>(data), size);
+            }
+
+            std::error_code error;
+            std::filesystem::rename(tempFilepath, filepath, error);
+            return !error;
+        }
+    }
+
+    VulkanShaderCache::VulkanShaderCache(const std::filesystem::path& directory)
+        : m_Directory(directory), m_IndexFilepath(directory / "index.txt")
+    {
+        std::filesystem::create_directories(m_Directory);
+
+        loadIndex();
+        evictUnreferenced();
+    }
+
+    bool VulkanShaderCache::load(const std::string& key, uint64_t hash, const std::vector<std::string>& dependencies, std::vector<uint32_t>& spirv)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        if (!readBinaryLocked(hash, spirv))
+        {
+            return false;
+        }
+
+        updateEntryLocked(key, hash, dependencies);
+        return true;
+    }
+
+    bool VulkanShaderCache::readBinaryLocked(uint64_t hash, std::vector<uint32_t>& spirv)
+    {
+        std::ifstream in(getBinaryFilepath(hash), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+        {
+            return false;
+        }
+
+        size_t size = static_cast<size_t>(in.tellg());
+        if (size < sizeof(uint32_t) || size % sizeof(uint32_t) != 0)
+        {
+            AST_CORE_WARN("Discarding corrupted shader cache entry {0}.", Utils::hashToString(hash));
+            return false;
+        }
+
+        spirv.resize(size / sizeof(uint32_t));
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char*>(spirv.data()), size);
+
+        if (!in || spirv[0] != Utils::s_SpirvMagicNumber)
+        {
+            AST_CORE_WARN("Discarding corrupted shader cache entry {0}.", Utils::hashToString(hash));
+            spirv.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void VulkanShaderCache::store(const std::string& key, uint64_t hash, const std::vector<uint32_t>& spirv, const std::vector<std::string>& dependencies)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        std::filesystem::path binaryFilepath = getBinaryFilepath(hash);
+        if (!Utils::writeFileAtomically(binaryFilepath, spirv.data(), spirv.size() * sizeof(uint32_t)))
+        {
+            AST_CORE_WARN("Failed to write shader cache entry: {0}", binaryFilepath.string());
+            return;
+        }
+
+        updateEntryLocked(key, hash, dependencies);
+    }
+
+    std::vector<std::string> VulkanShaderCache::getDependencies(const std::string& key)
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        auto it = m_Entries.find(key);
+        return it == m_Entries.end() ? std::vector<std::string>{} : it->second.dependencies;
+    }
+
+    uint64_t VulkanShaderCache::hash(const void* data, size_t size, uint64_t seed)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+        uint64_t result = seed;
+        for (size_t i = 0; i < size; i++)
+        {
+            result ^= bytes[i];
+            result *= 0x100000001b3ull;
+        }
+        return result;
+    }
+
+    void VulkanShaderCache::updateEntryLocked(const std::string& key, uint64_t hash, const std::vector<std::string>& dependencies)
+    {
+        auto [it, inserted] = m_Entries.try_emplace(key, Entry{ hash, dependencies });
+        if (!inserted)
+        {
+            // [NOTE] The included files are part of the hash, so the same hash always comes with the same dependencies.
+            if (it->second.hash == hash)
+            {
+                return;
+            }
+
+            uint64_t staleHash = it->second.hash;
+            it->second = { hash, dependencies };
+
+            bool referenced = std::any_of(m_Entries.begin(), m_Entries.end(),
+                [staleHash](const auto& entry) { return entry.second.hash == staleHash; });
+            if (!referenced)
+            {
+                AST_CORE_DEBUG("Evicting stale shader cache entry {0} ({1}).", Utils::hashToString(staleHash), key);
+
+                std::error_code error;
+                std::filesystem::remove(getBinaryFilepath(staleHash), error);
+            }
+        }
+
+        saveIndex();
+    }
+
+    std::filesystem::path VulkanShaderCache::getBinaryFilepath(uint64_t hash) const
+    {
+        return m_Directory / (Utils::hashToString(hash) + ".spv");
+    }
+
+    void VulkanShaderCache::loadIndex()
+    {
+        std::ifstream in(m_IndexFilepath, std::ios::in);
+        if (!in.is_open())
+        {
+            return;
+        }
+
+        // Index layout:
+        //     version <format version>
+        //     <hash> <key>
+        //     \t<dependency>
+        //     ...
+        std::string token;
+        uint32_t version = 0;
+        if (!(in >> token >> version) || token != "version" || version != s_FormatVersion)
+        {
+            AST_CORE_INFO("Shader cache was written by another version, rebuilding it.");
+            return;
+        }
+
+        Entry* entry = nullptr;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.starts_with('\t'))
+            {
+                if (entry)
+                {
+                    entry->dependencies.push_back(line.substr(1));
+                }
+                continue;
+            }
+
+            entry = nullptr;
+            size_t separator = line.find(' ');
+            if (separator == std::string::npos)
+            {
+                continue;
+            }
+
+            uint64_t hash = std::strtoull(line.substr(0, separator).c_str(), nullptr, 16);
+            std::string key = line.substr(separator + 1);
+
+            // [NOTE] Entries whose binary has been deleted by hand are dropped, they will simply be recompiled.
+            if (std::filesystem::exists(getBinaryFilepath(hash)))
+            {
+                entry = &m_Entries[key];
+                entry->hash = hash;
+            }
+        }
+
+        AST_CORE_DEBUG("Loaded shader cache index with {0} entries.", m_Entries.size());
+    }
+
+    void VulkanShaderCache::saveIndex()
+    {
+        std::string contents = std::format("version {}\n", s_FormatVersion);
+        for (auto& [key, entry] : m_Entries)
+        {
+            contents += Utils::hashToString(entry.hash) + " " + key + "\n";
+            for (const auto& dependency : entry.dependencies)
+            {
+                contents += "\t" + dependency + "\n";
+            }
+        }
+
+        if (!Utils::writeFileAtomically(m_IndexFilepath, contents.data(), contents.size()))
+        {
+            AST_CORE_WARN("Failed to write shader cache index: {0}", m_IndexFilepath.string());
+        }
+    }
+
+    void VulkanShaderCache::evictUnreferenced()
+    {
+        std::unordered_set<std::string> referenced;
+        for (auto& [key, entry] : m_Entries)
+        {
+            referenced.insert(Utils::hashToString(entry.hash) + ".spv");
+        }
+
+        // Also sweeps leftover temporary files and binaries from older cache layouts.
+        std::error_code error;
+        for (auto& entry : std::filesystem::directory_iterator(m_Directory, error))
+        {
+            std::filesystem::path filepath = entry.path();
+            if (!entry.is_regular_file() || filepath == m_IndexFilepath)
+            {
+                continue;
+            }
+
+            std::string filename = filepath.filename().string();
+            if (referenced.contains(filename))
+            {
+                continue;
+            }
+
+            AST_CORE_DEBUG("Evicting unreferenced shader cache file {0}.", filename);
+            std::filesystem::remove(filepath, error);
+        }
+    }
+}
@@ -1,11 +1,17 @@
 #include "pch.hpp"
 #include "Astranox/platform/vulkan/VulkanShaderCompiler.hpp"
 #include "Astranox/platform/vulkan/VulkanShader.hpp"
+#include "Astranox/platform/vulkan/VulkanShaderCache.hpp"
+#include "Astranox/platform/vulkan/VulkanBindlessTextureRegistry.hpp"
 #include "Astranox/core/Timer.hpp"
+#include "Astranox/core/ThreadPool.hpp"
+#include "Astranox/rendering/Renderer.hpp"
 
 #include "shaderc/glslc/src/file_compiler.h"
 #include "spirv_cross/spirv_cross.hpp"
 
+#include <sstream>
+
 
 namespace Astranox
 {
@@ -21,8 +27,12 @@ namespace Astranox
             {
                 return VK_SHADER_STAGE_FRAGMENT_BIT;
             }
+            if (type == "compute")
+            {
+                return VK_SHADER_STAGE_COMPUTE_BIT;
+            }
 
-            AST_CORE_ASSERT(false, "Unknown shader type");
+            // [NOTE] Reported by the caller: a typo in a hot-reloaded source must not bring the application down.
             return static_cast<VkShaderStageFlagBits>(0);
         }
 
@@ -31,21 +41,114 @@ namespace Astranox
             return std::filesystem::path("assets/cache/shader/Vulkan");
         }
 
-        static void createCacheDirectoryIfNeeded()
+        static VulkanShaderCache& getShaderCache()
+        {
+            static VulkanShaderCache s_ShaderCache(getCacheDirectory());
+            return s_ShaderCache;
+        }
+
+        // Searched by `#include <file>`, while `#include "file"` is relative to the including file.
+        static std::filesystem::path getIncludeDirectory()
+        {
+            return std::filesystem::path("assets/shaders/include");
+        }
+
+        static bool readTextFile(const std::filesystem::path& filepath, std::string& contents)
+        {
+            std::ifstream in(filepath, std::ios::in | std::ios::binary);
+            if (!in.is_open())
+            {
+                return false;
+            }
+
+            contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            return true;
+        }
+
+        /**
+         * @brief Chain the path and the current contents of every included file into `hash`.
+         */
+        static uint64_t hashDependencies(uint64_t hash, const std::vector<std::string>& dependencies)
         {
-            std::filesystem::path cacheDirectory = getCacheDirectory();
-            if (!std::filesystem::exists(cacheDirectory))
+            for (const auto& dependency : dependencies)
             {
-                std::filesystem::create_directories(cacheDirectory);
+                hash = VulkanShaderCache::hash(dependency, hash);
+
+                // [NOTE] A missing file hashes as its path alone, which can only miss the cache and report the error.
+                std::string contents;
+                if (readTextFile(dependency, contents))
+                {
+                    hash = VulkanShaderCache::hash(contents, hash);
+                }
             }
+            return hash;
         }
 
+        /**
+         * Resolves the `#include` directives of one stage, and records every file it opens.
+         */
+        class ShaderIncluder final: public shaderc::CompileOptions::IncluderInterface
+        {
+        public:
+            ShaderIncluder(std::vector<std::string>& dependencies)
+                : m_Dependencies(dependencies) {}
+
+            shaderc_include_result* GetInclude(const char* requestedSource, shaderc_include_type type,
+                const char* requestingSource, size_t includeDepth) override
+            {
+                std::filesystem::path filepath = type == shaderc_include_type_relative
+                    ? std::filesystem::path(requestingSource).parent_path() / requestedSource
+                    : getIncludeDirectory() / requestedSource;
+                filepath = filepath.lexically_normal();
+
+                IncludeData* include = new IncludeData;
+                if (readTextFile(filepath, include->content))
+                {
+                    include->sourceName = filepath.generic_string();
+                    if (std::find(m_Dependencies.begin(), m_Dependencies.end(), include->sourceName) == m_Dependencies.end())
+                    {
+                        m_Dependencies.push_back(include->sourceName);
+                    }
+                }
+                else
+                {
+                    // [NOTE] An empty source name tells shaderc that the include failed, the content is the error message.
+                    include->content = std::format("Cannot open include file {}", filepath.generic_string());
+                }
+
+                include->result = {
+                    .source_name = include->sourceName.data(),
+                    .source_name_length = include->sourceName.size(),
+                    .content = include->content.data(),
+                    .content_length = include->content.size(),
+                    .user_data = include,
+                };
+                return &include->result;
+            }
+
+            void ReleaseInclude(shaderc_include_result* data) override
+            {
+                delete static_cast<IncludeData*>(data->user_data);
+            }
+
+        private:
+            struct IncludeData
+            {
+                std::string sourceName;
+                std::string content;
+                shaderc_include_result result;
+            };
+
+            std::vector<std::string>& m_Dependencies;
+        };
+
         static shaderc_shader_kind vulkanShaderStageToShaderc(VkShaderStageFlagBits stage)
         {
             switch (stage)
             {
                 case VK_SHADER_STAGE_VERTEX_BIT: { return shaderc_glsl_vertex_shader; }
                 case VK_SHADER_STAGE_FRAGMENT_BIT: { return shaderc_glsl_fragment_shader; }
+                case VK_SHADER_STAGE_COMPUTE_BIT: { return shaderc_glsl_compute_shader; }
             }
 
             AST_CORE_ASSERT(false, "Unknown shader stage");
@@ -58,22 +161,154 @@ namespace Astranox
             {
                 case VK_SHADER_STAGE_VERTEX_BIT: { return "vertex"; }
                 case VK_SHADER_STAGE_FRAGMENT_BIT: { return "fragment"; }
+                case VK_SHADER_STAGE_COMPUTE_BIT: { return "compute"; }
             }
 
             AST_CORE_ASSERT(false, "Unknown shader stage");
             return "";
         }
 
-        static std::string vulkanShaderStageCachedVulkanFileExtension(VkShaderStageFlagBits stage)
+        static VkFormat spirTypeToVkFormat(const spirv_cross::SPIRType& type)
         {
-            switch (stage)
+            // [NOTE] A matrix input is described by the format of one column, like ShaderDataType::Mat4.
+            const uint32_t componentCount = type.vecsize;
+            switch (type.basetype)
             {
-                case VK_SHADER_STAGE_VERTEX_BIT: { return ".vert.spv"; }
-                case VK_SHADER_STAGE_FRAGMENT_BIT: { return ".frag.spv"; }
+                case spirv_cross::SPIRType::Float:
+                {
+                    constexpr VkFormat formats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+                    return formats[componentCount - 1];
+                }
+                case spirv_cross::SPIRType::Int:
+                {
+                    constexpr VkFormat formats[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+                    return formats[componentCount - 1];
+                }
+                case spirv_cross::SPIRType::UInt:
+                {
+                    constexpr VkFormat formats[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+                    return formats[componentCount - 1];
+                }
             }
 
-            AST_CORE_ASSERT(false, "Unknown shader stage");
-            return "";
+            return VK_FORMAT_UNDEFINED;  // Reported by the caller
+        }
+
+        static ShaderDescriptorSetInfo& getSetInfo(ShaderReflectionData& reflectionData, uint32_t set)
+        {
+            auto& descriptorSets = reflectionData.descriptorSets;
+            if (descriptorSets.size() <= set)
+            {
+                descriptorSets.resize(set + 1);
+            }
+            return descriptorSets[set];
+        }
+
+        template<typename Info>
+        static void mergeBindings(std::map<uint32_t, Info>& dst, const std::map<uint32_t, Info>& src)
+        {
+            for (auto& [binding, info] : src)
+            {
+                auto [it, inserted] = dst.try_emplace(binding, info);
+                if (!inserted)
+                {
+                    it->second.shaderStage |= info.shaderStage;
+                }
+            }
+        }
+
+        /**
+         * @brief Merge the reflection data of one stage into that of the whole shader.
+         * @return False if the stages disagree, the error is logged.
+         */
+        static bool mergeReflectionData(ShaderReflectionData& dst, const ShaderReflectionData& src)
+        {
+            for (uint32_t set = 0; set < src.descriptorSets.size(); ++set)
+            {
+                ShaderDescriptorSetInfo& dstSet = getSetInfo(dst, set);
+                const ShaderDescriptorSetInfo& srcSet = src.descriptorSets[set];
+
+                mergeBindings(dstSet.uniformBufferInfos, srcSet.uniformBufferInfos);
+                mergeBindings(dstSet.imageSamplerInfos, srcSet.imageSamplerInfos);
+                mergeBindings(dstSet.storageBufferInfos, srcSet.storageBufferInfos);
+                mergeBindings(dstSet.storageImageInfos, srcSet.storageImageInfos);
+            }
+
+            for (const PushConstantInfo& pushConstant : src.pushConstants)
+            {
+                auto it = std::find_if(dst.pushConstants.begin(), dst.pushConstants.end(),
+                    [&pushConstant](const PushConstantInfo& info) { return info.name == pushConstant.name; });
+                if (it == dst.pushConstants.end())
+                {
+                    dst.pushConstants.push_back(pushConstant);
+                    continue;
+                }
+
+                uint32_t end = std::max(it->offset + it->size, pushConstant.offset + pushConstant.size);
+                it->offset = std::min(it->offset, pushConstant.offset);
+                it->size = end - it->offset;
+                it->shaderStage |= pushConstant.shaderStage;
+            }
+
+            // Only the vertex stage has inputs
+            dst.vertexInputs.insert(dst.vertexInputs.end(), src.vertexInputs.begin(), src.vertexInputs.end());
+
+            for (const SpecializationConstantInfo& constant : src.specializationConstants)
+            {
+                auto it = std::find_if(dst.specializationConstants.begin(), dst.specializationConstants.end(),
+                    [&constant](const SpecializationConstantInfo& info) { return info.constantID == constant.constantID; });
+                if (it == dst.specializationConstants.end())
+                {
+                    dst.specializationConstants.push_back(constant);
+                    continue;
+                }
+
+                if (it->name != constant.name)
+                {
+                    AST_CORE_ERROR("Specialization constant {0} is named {1} and {2} in different stages!",
+                        constant.constantID, it->name, constant.name);
+                    return false;
+                }
+                it->shaderStage |= constant.shaderStage;
+            }
+            std::sort(dst.specializationConstants.begin(), dst.specializationConstants.end(),
+                [](const SpecializationConstantInfo& a, const SpecializationConstantInfo& b) { return a.constantID < b.constantID; });
+
+            dst.usesBindlessTextures |= src.usesBindlessTextures;
+            return true;
+        }
+
+        /**
+         * @brief Run `jobs` on the renderer's thread pool and wait for all of them.
+         * The calling thread works on the first job instead of idling.
+         */
+        static void runJobs(const std::vector<std::function<void()>>& jobs)
+        {
+            // [NOTE] A worker waiting for jobs queued behind it could starve the pool, so nested batches run inline.
+            if (jobs.size() <= 1 || ThreadPool::isWorkerThread())
+            {
+                for (const auto& job : jobs)
+                {
+                    job();
+                }
+                return;
+            }
+
+            ThreadPool& threadPool = Renderer::getThreadPool();
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(jobs.size() - 1);
+            for (size_t i = 1; i < jobs.size(); ++i)
+            {
+                futures.push_back(threadPool.submit(jobs[i]));
+            }
+
+            jobs[0]();
+
+            for (auto& future : futures)
+            {
+                future.get();
+            }
         }
 
         static std::string extractNameFromFilepath(const std::filesystem::path& filepath)
@@ -89,50 +324,134 @@ namespace Astranox
         }
     }
 
-    VulkanShaderCompiler::VulkanShaderCompiler(const std::filesystem::path& shaderFilepath)
-        : m_ShaderFilepath(shaderFilepath)
+    VulkanShaderCompiler::VulkanShaderCompiler(const std::filesystem::path& shaderFilepath, const ShaderDefines& defines)
+        : m_ShaderFilepath(shaderFilepath), m_Defines(defines)
     {
     }
 
-    Ref<VulkanShader> VulkanShaderCompiler::compile(const std::filesystem::path& shaderFilepath)
+    Ref<VulkanShader> VulkanShaderCompiler::compile(const std::filesystem::path& shaderFilepath, const ShaderDefines& defines)
     {
-        Ref<VulkanShader> shader = Ref<VulkanShader>::create();
-        shader->m_Filepath = shaderFilepath;
-        shader->m_Name = Utils::extractNameFromFilepath(shaderFilepath);
+        Ref<VulkanShader> shader = compileBatch({ shaderFilepath }, defines)[0];
+        AST_CORE_ASSERT(shader, "Failed to compile shader {0}!", shaderFilepath.string());
+        return shader;
+    }
 
-        Ref<VulkanShaderCompiler> compiler = Ref<VulkanShaderCompiler>::create(shaderFilepath);
-        AST_CORE_TRACE("[VulkanShaderCompiler] Processing {0}...", shaderFilepath.string());
-        compiler->process();
+    std::vector<Ref<VulkanShader>> VulkanShaderCompiler::compileBatch(const std::vector<std::filesystem::path>& shaderFilepaths, const ShaderDefines& defines)
+    {
+        Timer timer;
 
-        shader->createShaders(compiler->getShaderData());
+        std::vector<Ref<VulkanShaderCompiler>> compilers;
+        compilers.reserve(shaderFilepaths.size());
+        for (const auto& shaderFilepath : shaderFilepaths)
+        {
+            AST_CORE_TRACE("[VulkanShaderCompiler] Processing {0}...", shaderFilepath.string());
 
-        // [TODO] Extract from reflection data.
-        ShaderDescriptorSetInfo sdsi;
-        sdsi.uniformBufferInfos = {
-            { 0, { 1, VK_SHADER_STAGE_VERTEX_BIT, "u_Camera" } },
-        };
-        sdsi.imageSamplerInfos = {
-            { 1, { 32, VK_SHADER_STAGE_FRAGMENT_BIT, "u_Textures" }}
-        };
-        shader->setDescriptorSetInfo(sdsi);
+            Ref<VulkanShaderCompiler> compiler = Ref<VulkanShaderCompiler>::create(shaderFilepath, defines);
+            compiler->preprocess();
+            compilers.push_back(compiler);
+        }
 
-        shader->createDescriptorSetLayouts();
+        // Every stage of every shader is an independent job: cache lookup or compilation, then reflection.
+        std::vector<std::function<void()>> jobs;
+        for (auto& compiler : compilers)
+        {
+            for (auto& [stage, source] : compiler->m_ShaderSources)
+            {
+                jobs.push_back([compiler, stage]() { compiler->compileStage(stage); });
+            }
+        }
+        Utils::runJobs(jobs);
 
-        return shader;
+        std::vector<Ref<VulkanShader>> shaders;
+        shaders.reserve(compilers.size());
+        for (auto& compiler : compilers)
+        {
+            shaders.push_back(compiler->createShader());
+        }
+
+        AST_CORE_TRACE("[VulkanShaderCompiler] Processing {0} shaders ({1} stages) took {2} ms.", shaders.size(), jobs.size(), timer.getElapsedMilliseconds());
+        return shaders;
     }
 
-    void VulkanShaderCompiler::process()
+    void VulkanShaderCompiler::preprocess()
     {
-        Utils::createCacheDirectoryIfNeeded();
-
         std::string srcCode = readFile(m_ShaderFilepath);
-        auto shaderSources = parseShader(srcCode);
+        m_ShaderSources = parseShader(srcCode);
+        if (m_ShaderSources.empty() && !m_Failed)
+        {
+            AST_CORE_ERROR("No shader stage found in {0}.", m_ShaderFilepath.string());
+            m_Failed = true;
+        }
 
+        // [NOTE] Every stage gets its slots up front, so the stage jobs only write to their own elements.
+        for (auto& [stage, source] : m_ShaderSources)
         {
-            Timer timer;
-            compileOrGetVulkanBinaries(shaderSources);
-            AST_CORE_TRACE("[VulkanShaderCompiler] Processing took {0} ms.", timer.getElapsedMilliseconds());
+            m_ShaderData[stage];
+            m_StageDependencies[stage];
+            m_StageReflectionData[stage];
         }
+
+        // Everything other than the stage source that changes the generated code.
+        unsigned int spvVersion = 0;
+        unsigned int spvRevision = 0;
+        shaderc_get_spv_version(&spvVersion, &spvRevision);
+
+        const uint32_t optionValues[] = {
+            spvVersion,
+            spvRevision,
+            static_cast<uint32_t>(shaderc_env_version_vulkan_1_3),
+            static_cast<uint32_t>(s_Optimize),
+            static_cast<uint32_t>(s_GenerateDebugInfo),
+        };
+        m_OptionsHash = VulkanShaderCache::hash(optionValues, sizeof(optionValues));
+
+        m_DefinesHash = VulkanShaderCache::hash("");
+        for (auto& [name, value] : m_Defines)
+        {
+            m_DefinesHash = VulkanShaderCache::hash(name + "=" + value + ";", m_DefinesHash);
+        }
+    }
+
+    Ref<VulkanShader> VulkanShaderCompiler::createShader()
+    {
+        if (m_Failed)
+        {
+            return nullptr;
+        }
+
+        // Stages are merged in a fixed order, so the result does not depend on which job finished first.
+        for (auto& [stage, stageReflectionData] : m_StageReflectionData)
+        {
+            if (!Utils::mergeReflectionData(m_ReflectionData, stageReflectionData))
+            {
+                AST_CORE_ERROR("Stages of {0} do not match.", m_ShaderFilepath.string());
+                return nullptr;
+            }
+        }
+
+        Ref<VulkanShader> shader = Ref<VulkanShader>::create();
+        shader->m_Filepath = m_ShaderFilepath;
+        shader->m_Name = Utils::extractNameFromFilepath(m_ShaderFilepath);
+        shader->m_Keywords = m_Keywords;
+        for (auto& [stage, dependencies] : m_StageDependencies)
+        {
+            for (const auto& dependency : dependencies)
+            {
+                std::filesystem::path filepath(dependency);
+                if (std::find(shader->m_Dependencies.begin(), shader->m_Dependencies.end(), filepath) == shader->m_Dependencies.end())
+                {
+                    shader->m_Dependencies.push_back(filepath);
+                }
+            }
+        }
+
+        shader->createShaders(m_ShaderData);
+
+        shader->m_ReflectionData = m_ReflectionData;
+        shader->createDescriptorSetLayouts();
+        shader->createPushConstantRanges();
+
+        return shader;
     }
 
     std::string VulkanShaderCompiler::readFile(const std::filesystem::path& filepath)
@@ -140,7 +459,12 @@ namespace Astranox
         std::string srcCode;
 
         std::ifstream in(filepath, std::ios::ate | std::ios::binary);
-        AST_CORE_ASSERT(in.is_open(), "Failed to open file: {0}", filepath.string());
+        if (!in.is_open())
+        {
+            AST_CORE_ERROR("Failed to open file: {0}", filepath.string());
+            m_Failed = true;
+            return srcCode;
+        }
 
         in.seekg(0, std::ios::end);
         srcCode.resize(in.tellg());
@@ -160,14 +484,47 @@ namespace Astranox
         size_t typeTokenLength = strlen(typeToken);
         size_t pos = srcCode.find(typeToken, 0);
 
+        // Keywords of the variants are declared once, before the first stage: `#keywords ALPHA_TEST SKINNING`
+        const char* keywordsToken = "#keywords";
+        size_t keywordsPos = srcCode.find(keywordsToken, 0);
+        if (keywordsPos != std::string::npos)
+        {
+            if (keywordsPos > pos)
+            {
+                AST_CORE_ERROR("#keywords must precede the first #type in {0}!", m_ShaderFilepath.string());
+                m_Failed = true;
+                return {};
+            }
+
+            size_t begin = keywordsPos + strlen(keywordsToken);
+            size_t eol = srcCode.find_first_of("\r\n", begin);
+            std::istringstream keywords(srcCode.substr(begin, eol == std::string::npos ? std::string::npos : eol - begin));
+
+            std::string keyword;
+            while (keywords >> keyword)
+            {
+                m_Keywords.push_back(keyword);
+            }
+        }
+
         while (pos != std::string::npos)
         {
             size_t eol = srcCode.find_first_of("\r\n", pos);
-            AST_CORE_ASSERT(eol != std::string::npos, "Syntax error");
+            if (eol == std::string::npos)
+            {
+                AST_CORE_ERROR("Syntax error in {0}: #type is not followed by a stage.", m_ShaderFilepath.string());
+                m_Failed = true;
+                return {};
+            }
 
             size_t begin = pos + typeTokenLength + 1;
             std::string type = srcCode.substr(begin, eol - begin);
-            AST_CORE_ASSERT(Utils::shaderTypeFromString(type), "Invalid shader type specified");
+            if (!Utils::shaderTypeFromString(type))
+            {
+                AST_CORE_ERROR("Invalid shader type '{0}' in {1}.", type, m_ShaderFilepath.string());
+                m_Failed = true;
+                return {};
+            }
 
 
             size_t nextLinePos = srcCode.find_first_not_of("\r\n", eol);
@@ -179,73 +536,78 @@ namespace Astranox
         return shaderSources;
     }
 
-    void VulkanShaderCompiler::compileOrGetVulkanBinaries(const std::map<VkShaderStageFlagBits, std::string>& shaderSources)
+    void VulkanShaderCompiler::compileStage(VkShaderStageFlagBits stage)
     {
-        shaderc::Compiler compiler;
+        const std::string& source = m_ShaderSources.at(stage);
+        auto& data = m_ShaderData.at(stage);
+        auto& dependencies = m_StageDependencies.at(stage);
+
+        uint32_t stageValue = static_cast<uint32_t>(stage);
+        uint64_t sourceHash = VulkanShaderCache::hash(&stageValue, sizeof(stageValue), m_OptionsHash ^ m_DefinesHash);
+        sourceHash = VulkanShaderCache::hash(source, sourceHash);
 
-        shaderc::CompileOptions options;
-        options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
-        const bool optimize = true;
-        if (optimize)
+        // [NOTE] Each variant of a stage has its own entry, so switching between variants never evicts the other ones.
+        std::string key = m_ShaderFilepath.generic_string() + ":" + Utils::vulkanShaderStageToString(stage);
+        if (!m_Defines.empty())
         {
-            options.SetOptimizationLevel(shaderc_optimization_level_performance);
+            key += std::format(":{:016x}", m_DefinesHash);
         }
 
-        std::filesystem::path cacheDirectory = Utils::getCacheDirectory();
+        // The files included by the previous build are only known from the cache. If the source or any of them changed,
+        // the hash misses, and compiling finds the files that are included now.
+        VulkanShaderCache& cache = Utils::getShaderCache();
+        dependencies = cache.getDependencies(key);
+        uint64_t hash = Utils::hashDependencies(sourceHash, dependencies);
 
-        m_ShaderData.clear();
-
-        for (auto& [stage, source] : shaderSources)
+        if (cache.load(key, hash, dependencies, data))
         {
-            std::filesystem::path cachePath = cacheDirectory / (m_ShaderFilepath.filename().string() + Utils::vulkanShaderStageCachedVulkanFileExtension(stage));
-
-            std::ifstream in(cachePath, std::ios::in | std::ios::binary);
-            if (in.is_open())
-            {
-                AST_CORE_DEBUG("Found cache file for {0} shader.", Utils::vulkanShaderStageToString(stage));
+            AST_CORE_DEBUG("Found cached binary for {0} shader.", Utils::vulkanShaderStageToString(stage));
+        }
+        else
+        {
+            AST_CORE_DEBUG("Compiling {0} shader...", Utils::vulkanShaderStageToString(stage));
 
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
+            // [NOTE] Each job has its own compiler, so stages never contend for one.
+            shaderc::Compiler compiler;
 
-                auto& data = m_ShaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read(reinterpret_cast<char*>(data.data()), size);
-            } else
+            shaderc::CompileOptions options;
+            options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
+            if (s_GenerateDebugInfo)
             {
-                AST_CORE_DEBUG("Compiling {0} shader...", Utils::vulkanShaderStageToString(stage));
-
-                shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
-                    source, Utils::vulkanShaderStageToShaderc(stage), m_ShaderFilepath.string().c_str(), options);
+                options.SetGenerateDebugInfo();
+            }
+            if (s_Optimize)
+            {
+                options.SetOptimizationLevel(shaderc_optimization_level_performance);
+            }
+            for (auto& [name, value] : m_Defines)
+            {
+                options.AddMacroDefinition(name, value);
+            }
 
-                if (result.GetCompilationStatus() != shaderc_compilation_status_success)
-                {
-                    AST_CORE_ERROR("Compilation failed: {0}", result.GetErrorMessage());
-                    AST_CORE_ASSERT(false, "")
-                }
+            dependencies.clear();
+            options.SetIncluder(std::make_unique<Utils::ShaderIncluder>(dependencies));
 
-                // Copy the binary data to the shader data.
-                m_ShaderData[stage] = std::vector<uint32_t>(result.cbegin(), result.cend());
+            shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+                source, Utils::vulkanShaderStageToShaderc(stage), m_ShaderFilepath.string().c_str(), options);
 
-                // Write the binary data to the cache file.
-                std::ofstream out(cachePath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto& data = m_ShaderData[stage];
-                    out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
+            if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+            {
+                AST_CORE_ERROR("Compilation failed: {0}", result.GetErrorMessage());
+                m_Failed = true;
+                return;
             }
-        }
 
-        for (auto&& [stage, data] : m_ShaderData)
-        {
-            reflect(stage, data);
+            data = std::vector<uint32_t>(result.cbegin(), result.cend());
+
+            hash = Utils::hashDependencies(sourceHash, dependencies);
+            cache.store(key, hash, data, dependencies);
         }
+
+        reflect(stage, data, m_StageReflectionData.at(stage));
     }
 
-    void VulkanShaderCompiler::reflect(VkShaderStageFlagBits stage, const std::vector<uint32_t>& spirv)
+    void VulkanShaderCompiler::reflect(VkShaderStageFlagBits stage, const std::vector<uint32_t>& spirv, ShaderReflectionData& reflectionData)
     {
         spirv_cross::Compiler compiler(spirv);
         spirv_cross::ShaderResources resources = compiler.get_shader_resources();
@@ -257,24 +619,169 @@ namespace Astranox
         {
             const spirv_cross::SPIRType& bufferType = compiler.get_type(resource.base_type_id);
             size_t bufferSize = compiler.get_declared_struct_size(bufferType);
+            uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
             size_t memberCount = bufferType.member_types.size();
 
             AST_CORE_TRACE("    {0}", resource.name);
             AST_CORE_TRACE("        Size = {0}", bufferSize);
-            AST_CORE_TRACE("        Binding = {0}", binding);
+            AST_CORE_TRACE("        Set = {0}, Binding = {1}", set, binding);
             AST_CORE_TRACE("        Member count = {0}", memberCount);
+
+            auto& info = Utils::getSetInfo(reflectionData, set).uniformBufferInfos[binding];
+            info.count = 1;
+            info.shaderStage |= stage;
+            info.name = resource.name;
+        }
+
+        AST_CORE_TRACE("Storage buffers:");
+        for (auto& resource : resources.storage_buffers)
+        {
+            uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+            uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+
+            AST_CORE_TRACE("    {0}", resource.name);
+            AST_CORE_TRACE("        Set = {0}, Binding = {1}", set, binding);
+
+            auto& info = Utils::getSetInfo(reflectionData, set).storageBufferInfos[binding];
+            info.shaderStage |= stage;
+            info.name = resource.name;
+        }
+
+        AST_CORE_TRACE("Storage images:");
+        for (auto& resource : resources.storage_images)
+        {
+            uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+            uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+            const auto& type = compiler.get_type(resource.type_id);
+            uint32_t arraySize = type.array.empty() ? 1 : type.array[0];
+
+            AST_CORE_TRACE("    {0}", resource.name);
+            AST_CORE_TRACE("        Set = {0}, Binding = {1}", set, binding);
+            AST_CORE_TRACE("        Array size = {0}", arraySize);
+
+            auto& info = Utils::getSetInfo(reflectionData, set).storageImageInfos[binding];
+            info.arraySize = arraySize;
+            info.shaderStage |= stage;
+            info.name = resource.name;
         }
 
         AST_CORE_TRACE("Sampled images:");
         for (auto& resource : resources.sampled_images)
         {
+            uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+            const auto& type = compiler.get_type(resource.type_id);
+            bool runtimeArray = !type.array.empty() && type.array[0] == 0;
+            uint32_t arraySize = type.array.empty() ? 1 : type.array[0];
 
             AST_CORE_TRACE("    {0}", resource.name);
-            AST_CORE_TRACE("        Binding = {0}", binding);
-            AST_CORE_TRACE("        Array size = {0}", compiler.get_type(resource.base_type_id).array.size());
+            AST_CORE_TRACE("        Set = {0}, Binding = {1}", set, binding);
+            AST_CORE_TRACE("        Array size = {0}", runtimeArray ? "unbounded" : std::to_string(arraySize));
+
+            // The bindless texture table is owned by the engine, not by the shader.
+            if (set == VulkanBindlessTextureRegistry::s_SetIndex)
+            {
+                if (binding != VulkanBindlessTextureRegistry::s_Binding || !runtimeArray)
+                {
+                    AST_CORE_ERROR("Set {0} is reserved for the bindless texture table ({1})!", set, resource.name);
+                    m_Failed = true;
+                    return;
+                }
+                reflectionData.usesBindlessTextures = true;
+                continue;
+            }
+            if (runtimeArray)
+            {
+                AST_CORE_ERROR("Unbounded texture arrays are only supported through the bindless texture table ({0})!", resource.name);
+                m_Failed = true;
+                return;
+            }
+
+            auto& info = Utils::getSetInfo(reflectionData, set).imageSamplerInfos[binding];
+            info.arraySize = arraySize;
+            info.shaderStage |= stage;
+            info.name = resource.name;
+        }
+
+        AST_CORE_TRACE("Push constants:");
+        for (auto& resource : resources.push_constant_buffers)
+        {
+            const spirv_cross::SPIRType& bufferType = compiler.get_type(resource.base_type_id);
+            uint32_t size = static_cast<uint32_t>(compiler.get_declared_struct_size(bufferType));
+
+            // [NOTE] Members may start at an explicit offset, so that stages can share one block without overlapping.
+            uint32_t offset = size;
+            for (uint32_t i = 0; i < bufferType.member_types.size(); ++i)
+            {
+                offset = std::min(offset, compiler.type_struct_member_offset(bufferType, i));
+            }
+            if (bufferType.member_types.empty())
+            {
+                offset = 0;
+            }
+
+            // Blocks of the same name are the same block seen from several stages (see mergeReflectionData)
+            std::string name = compiler.get_name(resource.base_type_id);
+
+            AST_CORE_TRACE("    {0}", name);
+            AST_CORE_TRACE("        Offset = {0}, Size = {1}", offset, size - offset);
+
+            reflectionData.pushConstants.push_back({ offset, size - offset, static_cast<VkShaderStageFlags>(stage), name });
+        }
+
+        AST_CORE_TRACE("Specialization constants:");
+        for (const spirv_cross::SpecializationConstant& constant : compiler.get_specialization_constants())
+        {
+            std::string name = compiler.get_name(constant.id);
+            if (name.empty())
+            {
+                // [NOTE] Pipelines set constants by name, so a binary without debug names cannot be specialized.
+                AST_CORE_ERROR("Specialization constant {0} of {1} has no name, the binary was stripped of debug info!",
+                    constant.constant_id, m_ShaderFilepath.string());
+                m_Failed = true;
+                return;
+            }
+
+            const spirv_cross::SPIRType& type = compiler.get_type(compiler.get_constant(constant.id).constant_type);
+
+            // [NOTE] Values are passed as 32-bit words, see VulkanPipeline::init.
+            if (type.vecsize != 1 || type.columns != 1 || type.width > 32)
+            {
+                AST_CORE_ERROR("Specialization constant {0} must be a 32-bit scalar!", name);
+                m_Failed = true;
+                return;
+            }
+
+            AST_CORE_TRACE("    {0}", name);
+            AST_CORE_TRACE("        Constant ID = {0}", constant.constant_id);
+
+            reflectionData.specializationConstants.push_back({ constant.constant_id, static_cast<VkShaderStageFlags>(stage), name });
+        }
+
+        if (stage == VK_SHADER_STAGE_VERTEX_BIT)
+        {
+            AST_CORE_TRACE("Vertex inputs:");
+            auto& vertexInputs = reflectionData.vertexInputs;
+            for (auto& resource : resources.stage_inputs)
+            {
+                uint32_t location = compiler.get_decoration(resource.id, spv::DecorationLocation);
+                VkFormat format = Utils::spirTypeToVkFormat(compiler.get_type(resource.type_id));
+                if (format == VK_FORMAT_UNDEFINED)
+                {
+                    AST_CORE_ERROR("Unsupported type of vertex input {0}!", resource.name);
+                    m_Failed = true;
+                    return;
+                }
+
+                AST_CORE_TRACE("    {0}", resource.name);
+                AST_CORE_TRACE("        Location = {0}", location);
+
+                vertexInputs.push_back({ location, format, resource.name });
+            }
+
+            std::sort(vertexInputs.begin(), vertexInputs.end(),
+                [](const VertexInputInfo& a, const VertexInputInfo& b) { return a.location < b.location; });
         }
     }
 }
-
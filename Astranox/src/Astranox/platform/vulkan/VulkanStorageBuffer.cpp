@@ -0,0 +1,65 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanStorageBuffer.hpp"
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
+#include "Astranox/platform/vulkan/VulkanMemoryAllocator.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    VulkanStorageBuffer::VulkanStorageBuffer(uint32_t bytes)
+        : m_Bytes(bytes)
+    {
+        m_Device = VulkanContext::get()->getDevice();
+
+        VulkanMemoryAllocator allocator("VulkanStorageBuffer");
+
+        // [NOTE] Compute, graphics and transfer may all touch the buffer, so it is shared between their families
+        // instead of being passed around with ownership transfers.
+        std::vector<uint32_t> queueFamilies = m_Device->getUniqueQueueFamilies();
+        bool concurrent = queueFamilies.size() > 1;
+        m_SharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+
+        VkBufferCreateInfo storageBufferCI{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = bytes,
+            .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                   | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                   | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+                   | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            .sharingMode = m_SharingMode,
+            .queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(queueFamilies.size()) : 0,
+            .pQueueFamilyIndices = concurrent ? queueFamilies.data() : nullptr,
+        };
+        m_StorageBufferAllocation = allocator.createBuffer(
+            storageBufferCI,
+            VMA_MEMORY_USAGE_GPU_ONLY,
+            m_StorageBuffer
+        );
+
+        m_DescriptorBufferInfo = {
+            .buffer = m_StorageBuffer,
+            .offset = 0,
+            .range = bytes
+        };
+    }
+
+    VulkanStorageBuffer::~VulkanStorageBuffer()
+    {
+        VulkanContext::get()->getDeletionQueue()->push(
+            [buffer = m_StorageBuffer, allocation = m_StorageBufferAllocation, uploadHandle = m_UploadHandle]() {
+                // The latest copy into this buffer may still be pending.
+                VulkanContext::get()->getUploadManager()->wait(uploadHandle);
+
+                VulkanMemoryAllocator allocator("VulkanStorageBuffer");
+                allocator.destroyBuffer(buffer, allocation);
+            }
+        );
+    }
+
+    void VulkanStorageBuffer::setData(const void* data, uint32_t bytes, uint32_t offset)
+    {
+        AST_CORE_ASSERT(offset + bytes <= m_Bytes, "Storage buffer overflow!");
+
+        m_UploadHandle = VulkanContext::get()->getUploadManager()->uploadBuffer(m_StorageBuffer, data, bytes, offset, m_SharingMode);
+    }
+}
@@ -17,9 +17,44 @@
 
 namespace Astranox
 {
-    VulkanSwapchain::VulkanSwapchain(Ref<VulkanDevice> device)
-        : m_Device(device)
+    // [NOTE] Mirrors the usual minImageCount + 1 of a surface.
+    static constexpr uint32_t s_OffscreenImageCount = 3;
+
+    static VkPresentModeKHR choosePresentMode(PresentPolicy policy, const std::vector<VkPresentModeKHR>& availableModes)
     {
+        std::vector<VkPresentModeKHR> candidates;
+        switch (policy)
+        {
+            case PresentPolicy::LowLatency: { candidates = { VK_PRESENT_MODE_MAILBOX_KHR }; break; }
+            case PresentPolicy::Throughput: { candidates = { VK_PRESENT_MODE_FIFO_RELAXED_KHR }; break; }
+            case PresentPolicy::VSync: { break; }
+            case PresentPolicy::Uncapped: { candidates = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR }; break; }
+        }
+
+        for (VkPresentModeKHR candidate : candidates)
+        {
+            if (std::find(availableModes.begin(), availableModes.end(), candidate) != availableModes.end())
+            {
+                return candidate;
+            }
+        }
+
+        // [NOTE] FIFO is the only mode every surface is required to support.
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    VulkanSwapchain::VulkanSwapchain(Ref<VulkanDevice> device, bool headless)
+        : m_Device(device), m_Headless(headless)
+    {
+        if (m_Headless)
+        {
+            // Without a surface, the graphics queue is the only queue we need.
+            m_GraphicsQueueIndex = m_Device->getPhysicalDevice()->getQueueIndices().graphicsFamily.value();
+            m_PresentQueueIndex = m_GraphicsQueueIndex;
+
+            m_ImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+            m_ColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+        }
     }
 
     void VulkanSwapchain::createSurface()
@@ -30,16 +65,132 @@ namespace Astranox
         GLFWwindow* windowHandle = static_cast<GLFWwindow*>(window.getHandle());
         VK_CHECK(::glfwCreateWindowSurface(instance, windowHandle, nullptr, &m_Surface));
 
+        m_PresentPolicy = window.getPresentPolicy();
+
         getQueueIndices();
         chooseSurfaceFormat();
     }
 
-    void VulkanSwapchain::createSwapchain(uint32_t width, uint32_t height)
+    bool VulkanSwapchain::createSwapchain(uint32_t width, uint32_t height)
+    {
+        bool created = m_Headless ? createOffscreenImages(width, height) : createPresentImages(width, height);
+        if (!created)
+        {
+            return false;
+        }
+
+        Ref<VulkanDeletionQueue> deletionQueue = VulkanContext::get()->getDeletionQueue();
+
+        // [NOTE] A framebuffer may be smaller than its attachments, so the depth buffer is kept when the extent only shrinks.
+        bool reuseDepth = m_DepthStencil.image
+            && m_SwapchainExtent.width <= m_DepthStencil.extent.width
+            && m_SwapchainExtent.height <= m_DepthStencil.extent.height;
+
+        if (!reuseDepth)
+        {
+            if (m_DepthStencil.image)
+            {
+                deletionQueue->push([device = m_Device->getRaw(), depthStencil = m_DepthStencil]() {
+                    VulkanMemoryAllocator allocator("VulkanSwapchain");
+                    ::vkDestroyImageView(device, depthStencil.imageView, nullptr);
+                    allocator.destroyImage(depthStencil.image, depthStencil.allocation);
+                });
+            }
+
+            createDepthStencil();
+        }
+
+        if (!m_RenderPass)
+        {
+            createRenderPass();
+        }
+
+        for (auto framebuffer : m_Framebuffers)
+        {
+            deletionQueue->push([device = m_Device->getRaw(), framebuffer]() {
+                ::vkDestroyFramebuffer(device, framebuffer, nullptr);
+            });
+        }
+        createFramebuffers();
+
+        destroyImageSyncObjects();
+        createImageSyncObjects();
+
+        if (m_Frames.empty())
+        {
+            createFrameContexts();
+        }
+
+        return true;
+    }
+
+    void VulkanSwapchain::createDepthStencil()
     {
         auto physicalDevice = m_Device->getPhysicalDevice();
 
         VulkanMemoryAllocator allocator("VulkanSwapchain");
 
+        VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        //if (m_ColorAttachment.image)
+        //{
+        //    ::vkDestroyImageView(m_Device->getRaw(), m_ColorAttachment.imageView, nullptr);
+        //    ::vkDestroyImage(m_Device->getRaw(), m_ColorAttachment.image, nullptr);
+        //    ::vkFreeMemory(m_Device->getRaw(), m_ColorAttachment.memory, nullptr);
+        //}
+        //VkFormat colorFormat = m_ImageFormat;
+
+        //VulkanBufferManager::createImage(
+        //    m_SwapchainExtent.width,
+        //    m_SwapchainExtent.height,
+        //    1,
+        //    msaaSamples,
+        //    colorFormat,
+        //    VK_IMAGE_TILING_OPTIMAL,
+        //    VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        //    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        //    m_ColorAttachment.image,
+        //    m_ColorAttachment.memory
+        //);
+
+        //m_ColorAttachment.imageView = createImageView(
+        //    m_ColorAttachment.image,
+        //    colorFormat,
+        //    VK_IMAGE_ASPECT_COLOR_BIT,
+        //    1
+        //);
+
+        uint32_t depthMipLevels = 1;
+
+        VkImageCreateInfo depthImageCI{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = physicalDevice->getDepthFormat(),
+            .extent = { m_SwapchainExtent.width, m_SwapchainExtent.height, 1 },
+            .mipLevels = depthMipLevels,
+            .arrayLayers = 1,
+            .samples = msaaSamples,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+        };
+
+        m_DepthStencil.allocation = allocator.createImage(depthImageCI, VMA_MEMORY_USAGE_GPU_ONLY, m_DepthStencil.image);
+
+        m_DepthStencil.imageView = createImageView(
+            m_DepthStencil.image,
+            physicalDevice->getDepthFormat(),
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            depthMipLevels
+        );
+        m_DepthStencil.extent = m_SwapchainExtent;
+    }
+
+    bool VulkanSwapchain::createPresentImages(uint32_t width, uint32_t height)
+    {
+        auto physicalDevice = m_Device->getPhysicalDevice();
+
         // Choose extent >>>
         VkSurfaceCapabilitiesKHR surfaceCapabilities{};
         VK_CHECK(::vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice->getRaw(), m_Surface, &surfaceCapabilities));
@@ -60,7 +211,7 @@ namespace Astranox
 
         if (m_SwapchainExtent.width == 0 || m_SwapchainExtent.height == 0) {
             AST_CORE_WARN("Attempting to create a swapchain with width or height of 0. Skipping...");
-            return;
+            return false;
         }
         //AST_CORE_TRACE("Swapchain size: {0}x{1}", m_SwapchainExtent.width, m_SwapchainExtent.height);
         // <<< Choose extent
@@ -74,21 +225,15 @@ namespace Astranox
         std::vector<VkPresentModeKHR> presentModes(presentModeCount);
         ::vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice->getRaw(), m_Surface, &presentModeCount, presentModes.data());
 
-        // [NOTE] We prefer VK_PRESENT_MODE_MAILBOX_KHR, but if not available, we choose VK_PRESENT_MODE_FIFO_KHR.
-        VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
-        for (const auto& mode: presentModes) {
-            if (mode == VK_PRESENT_MODE_MAILBOX_KHR) {
-                presentMode = mode;
-                break;
-            }
-        }
+        VkPresentModeKHR presentMode = choosePresentMode(m_PresentPolicy, presentModes);
         // <<< Choose present mode
 
-        uint32_t desiredImageCount = surfaceCapabilities.minImageCount + 1;
+        // [NOTE] The throughput policy queues one more image, so the GPU rarely waits for one to be released.
+        uint32_t desiredImageCount = surfaceCapabilities.minImageCount + (m_PresentPolicy == PresentPolicy::Throughput ? 2 : 1);
         if (surfaceCapabilities.maxImageCount > 0 && desiredImageCount > surfaceCapabilities.maxImageCount) {
             desiredImageCount = surfaceCapabilities.maxImageCount;
         }
-        AST_CORE_DEBUG("Desired number of swapchain images: {0}", desiredImageCount);
+        AST_CORE_DEBUG("Desired number of swapchain images: {0} (present mode: {1})", desiredImageCount, static_cast<int>(presentMode));
 
         VkSwapchainCreateInfoKHR createInfo{
             .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
@@ -103,7 +248,7 @@ namespace Astranox
             .compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
             .presentMode = presentMode,
             .clipped = VK_TRUE,
-            .oldSwapchain = VK_NULL_HANDLE
+            .oldSwapchain = m_Swapchain  // Lets the presentation engine hand its resources over
         };
 
         std::vector<uint32_t> queueFamilyIndices = { m_GraphicsQueueIndex, m_PresentQueueIndex };
@@ -117,102 +262,88 @@ namespace Astranox
             createInfo.pQueueFamilyIndices = queueFamilyIndices.data();
         }
 
-        if (m_Swapchain) {
-            ::vkDestroySwapchainKHR(m_Device->getRaw(), m_Swapchain, nullptr);
-        }
+        VkSwapchainKHR oldSwapchain = m_Swapchain;
         VK_CHECK(::vkCreateSwapchainKHR(m_Device->getRaw(), &createInfo, nullptr, &m_Swapchain));
 
-        // Destroy old image views
-        for (auto& image : m_Images)
-        {
-            ::vkDestroyImageView(m_Device->getRaw(), image.imageView, nullptr);
+        // [NOTE] The old swapchain is retired by the creation above, but frames in flight may still render into its images.
+        //        Its views go first, since they must not outlive the swapchain.
+        retireImages();
+        if (oldSwapchain) {
+            VulkanContext::get()->getDeletionQueue()->push([device = m_Device->getRaw(), oldSwapchain]() {
+                ::vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+            });
         }
+
         getSwapchainImages();
 
-        VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+        return true;
+    }
 
-        //if (m_ColorAttachment.image)
-        //{
-        //    ::vkDestroyImageView(m_Device->getRaw(), m_ColorAttachment.imageView, nullptr);
-        //    ::vkDestroyImage(m_Device->getRaw(), m_ColorAttachment.image, nullptr);
-        //    ::vkFreeMemory(m_Device->getRaw(), m_ColorAttachment.memory, nullptr);
-        //}
-        //VkFormat colorFormat = m_ImageFormat;
+    bool VulkanSwapchain::createOffscreenImages(uint32_t width, uint32_t height)
+    {
+        if (width == 0 || height == 0) {
+            AST_CORE_WARN("Attempting to create offscreen images with width or height of 0. Skipping...");
+            return false;
+        }
+        m_SwapchainExtent = { width, height };
 
-        //VulkanBufferManager::createImage(
-        //    m_SwapchainExtent.width,
-        //    m_SwapchainExtent.height,
-        //    1,
-        //    msaaSamples,
-        //    colorFormat,
-        //    VK_IMAGE_TILING_OPTIMAL,
-        //    VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-        //    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        //    m_ColorAttachment.image,
-        //    m_ColorAttachment.memory
-        //);
+        retireImages();
 
-        //m_ColorAttachment.imageView = createImageView(
-        //    m_ColorAttachment.image,
-        //    colorFormat,
-        //    VK_IMAGE_ASPECT_COLOR_BIT,
-        //    1
-        //);
-
-        if (m_DepthStencil.image)
-        {
-            ::vkDestroyImageView(m_Device->getRaw(), m_DepthStencil.imageView, nullptr);
-            allocator.destroyImage(m_DepthStencil.image, m_DepthStencil.allocation);
-        }
-        uint32_t depthMipLevels = 1;
+        VulkanMemoryAllocator allocator("VulkanSwapchain");
 
-        VkImageCreateInfo depthImageCI{
+        // [NOTE] TRANSFER_SRC lets frames be copied out (readback, image dumps) after rendering.
+        VkImageCreateInfo imageCI{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .imageType = VK_IMAGE_TYPE_2D,
-            .format = physicalDevice->getDepthFormat(),
+            .format = m_ImageFormat,
             .extent = { m_SwapchainExtent.width, m_SwapchainExtent.height, 1 },
-            .mipLevels = depthMipLevels,
+            .mipLevels = 1,
             .arrayLayers = 1,
-            .samples = msaaSamples,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
             .tiling = VK_IMAGE_TILING_OPTIMAL,
-            .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
             .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
         };
 
-        m_DepthStencil.allocation = allocator.createImage(depthImageCI, VMA_MEMORY_USAGE_GPU_ONLY, m_DepthStencil.image);
-
-        m_DepthStencil.imageView = createImageView(
-            m_DepthStencil.image,
-            physicalDevice->getDepthFormat(),
-            VK_IMAGE_ASPECT_DEPTH_BIT,
-            depthMipLevels
-        );
-
-        if (!m_RenderPass)
+        m_Images.resize(s_OffscreenImageCount);
+        for (auto& image : m_Images)
         {
-            createRenderPass();
+            image.allocation = allocator.createImage(imageCI, VMA_MEMORY_USAGE_GPU_ONLY, image.image);
+            image.imageView = createImageView(image.image, m_ImageFormat, VK_IMAGE_ASPECT_COLOR_BIT, 1);
         }
+        AST_CORE_TRACE("Created {0} offscreen images ({1}x{2})", m_Images.size(), m_SwapchainExtent.width, m_SwapchainExtent.height);
 
-        for (auto framebuffer : m_Framebuffers)
-        {
-            ::vkDestroyFramebuffer(m_Device->getRaw(), framebuffer, nullptr);
-        }
-        createFramebuffers();
+        return true;
+    }
 
-        uint32_t framesInFlight = static_cast<uint32_t>(m_Images.size());
-        m_CommandBuffers = m_Device->getCommandPool()->allocateCommandBuffers(framesInFlight);
+    void VulkanSwapchain::retireImages()
+    {
+        Ref<VulkanDeletionQueue> deletionQueue = VulkanContext::get()->getDeletionQueue();
 
-        if (m_InFlightFences.empty())
+        for (auto& image : m_Images)
         {
-            createSyncObjects();
+            deletionQueue->push([device = m_Device->getRaw(), image]() {
+                ::vkDestroyImageView(device, image.imageView, nullptr);
+
+                // Only offscreen images own their memory, surface images belong to the swapchain.
+                if (image.allocation)
+                {
+                    VulkanMemoryAllocator allocator("VulkanSwapchain");
+                    allocator.destroyImage(image.image, image.allocation);
+                }
+            });
         }
+        m_Images.clear();
     }
 
     void VulkanSwapchain::destroy()
     {
         m_Device->waitIdle();
 
+        // Retired swapchains have to go before the surface.
+        VulkanContext::get()->getDeletionQueue()->flush();
+
         VkDevice device = m_Device->getRaw();
         VulkanMemoryAllocator allocator("VulkanSwapchain");
 
@@ -223,90 +354,196 @@ namespace Astranox
         //::vkDestroyImage(device, m_ColorAttachment.image, nullptr);
         //::vkFreeMemory(device, m_ColorAttachment.memory, nullptr);
 
-        uint32_t framesInFlight = static_cast<uint32_t>(m_Images.size());
-        for (size_t i = 0; i < framesInFlight; i++)
+        for (auto& frame : m_Frames)
         {
-            ::vkDestroySemaphore(device, m_ImageAvailableSemaphores[i], nullptr);
-            ::vkDestroySemaphore(device, m_RenderFinishedSemaphores[i], nullptr);
+            ::vkDestroySemaphore(device, frame.imageAvailableSemaphore, nullptr);
+            ::vkDestroyFence(device, frame.inFlightFence, nullptr);
 
-            ::vkDestroyFence(device, m_InFlightFences[i], nullptr);
+            ::vkDestroySemaphore(device, frame.computeFinishedSemaphore, nullptr);
         }
+        m_Frames.clear();
+        ::vkDestroyCommandPool(device, m_ComputeCommandPool, nullptr);
+
+        destroyImageSyncObjects();
 
         for (auto framebuffer : m_Framebuffers)
         {
             ::vkDestroyFramebuffer(device, framebuffer, nullptr);
         }
 
+        ::vkDestroyRenderPass(device, m_RenderPass, nullptr);
+
         for (auto& image : m_Images)
         {
             ::vkDestroyImageView(device, image.imageView, nullptr);
+            if (image.allocation)
+            {
+                allocator.destroyImage(image.image, image.allocation);
+            }
         }
+        m_Images.clear();
 
-        ::vkDestroySwapchainKHR(device, m_Swapchain, nullptr);
+        if (m_Headless)
+        {
+            return;
+        }
 
-        ::vkDestroyRenderPass(device, m_RenderPass, nullptr);
+        ::vkDestroySwapchainKHR(device, m_Swapchain, nullptr);
 
         VkInstance instance = VulkanContext::getInstance();
         ::vkDestroySurfaceKHR(instance, m_Surface, nullptr);
     }
 
-    void VulkanSwapchain::resize(uint32_t width, uint32_t height)
+    bool VulkanSwapchain::resize(uint32_t width, uint32_t height)
     {
-        m_Device->waitIdle();
-        createSwapchain(width, height);
+        // [NOTE] No need to wait for the device: the old images, views and framebuffers go through the deletion queue.
+        return createSwapchain(width, height);
+    }
+
+    void VulkanSwapchain::setPresentPolicy(PresentPolicy policy)
+    {
+        if (policy == m_PresentPolicy)
+        {
+            return;
+        }
+
+        m_PresentPolicy = policy;
+        m_PresentPolicyChanged = !m_Headless;  // Nothing is presented in headless mode
     }
 
-    void VulkanSwapchain::beginFrame()
+    bool VulkanSwapchain::beginFrame()
     {
+        if (m_PresentPolicyChanged)
+        {
+            createSwapchain(m_SwapchainExtent.width, m_SwapchainExtent.height);
+            m_PresentPolicyChanged = false;
+        }
+
         uint32_t currentFrameIndex = Renderer::getCurrentFrameIndex();
+        FrameContext& frame = m_Frames[currentFrameIndex];
 
-        ::vkWaitForFences(m_Device->getRaw(), 1, &m_InFlightFences[currentFrameIndex], VK_TRUE, std::numeric_limits<uint64_t>::max());
-        ::vkResetFences(m_Device->getRaw(), 1, &m_InFlightFences[currentFrameIndex]);
+        ::vkWaitForFences(m_Device->getRaw(), 1, &frame.inFlightFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
 
-        VkResult result = ::vkAcquireNextImageKHR(
-            m_Device->getRaw(),
-            m_Swapchain,
-            std::numeric_limits<uint64_t>::max(),
-            m_ImageAvailableSemaphores[currentFrameIndex],
-            VK_NULL_HANDLE,
-            &m_CurrentImageIndex
-        );
+        // The frame is no longer in flight, so its resources (including its transient descriptor sets) can be recycled.
+        m_Device->getDescriptorAllocator()->resetFrame(currentFrameIndex);
+        VulkanContext::get()->getUploadManager()->retire();
+        VulkanContext::get()->getDeletionQueue()->beginFrame();
 
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-            this->resize(m_SwapchainExtent.width, m_SwapchainExtent.height);
-        } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-            VK_CHECK(result);
+        // The compute work of the frame is done as well (the graphics submission waited on it).
+        VK_CHECK(::vkResetCommandBuffer(frame.computeCommandBuffer, 0));
+
+        if (m_Headless)
+        {
+            // Offscreen images are owned by us, so they are simply used in turn.
+            m_CurrentImageIndex = (m_CurrentImageIndex + 1) % static_cast<uint32_t>(m_Images.size());
+        }
+        else
+        {
+            // [NOTE] A failed acquisition leaves the semaphore unsignaled, so acquire again from the new swapchain.
+            VkResult result = VK_ERROR_OUT_OF_DATE_KHR;
+            while (result == VK_ERROR_OUT_OF_DATE_KHR)
+            {
+                result = ::vkAcquireNextImageKHR(
+                    m_Device->getRaw(),
+                    m_Swapchain,
+                    std::numeric_limits<uint64_t>::max(),
+                    frame.imageAvailableSemaphore,
+                    VK_NULL_HANDLE,
+                    &m_CurrentImageIndex
+                );
+
+                if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                    if (!this->resize(m_SwapchainExtent.width, m_SwapchainExtent.height)) {
+                        // [NOTE] Nothing is submitted for this slot, so its fence stays signaled and does not cover
+                        //        the other frames anymore. Wait for them, so the deletion queue may run this slot again.
+                        VK_CHECK(::vkDeviceWaitIdle(m_Device->getRaw()));
+                        return false;
+                    }
+                } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+                    VK_CHECK(result);
+                }
+            }
         }
 
-        vkResetCommandBuffer(getCurrentCommandBuffer(), 0);
+        // [NOTE] Only reset once the frame is certain to be submitted, otherwise the next wait never returns.
+        ::vkResetFences(m_Device->getRaw(), 1, &frame.inFlightFence);
+
+        // [NOTE] Images are not tied to frame slots. If another frame is still rendering into
+        //        the image we got, wait for it (only possible with more frames in flight than images).
+        VkFence& imageFence = m_ImageFences[m_CurrentImageIndex];
+        if (imageFence != VK_NULL_HANDLE && imageFence != frame.inFlightFence)
+        {
+            ::vkWaitForFences(m_Device->getRaw(), 1, &imageFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        }
+        imageFence = frame.inFlightFence;
+
+        vkResetCommandBuffer(frame.commandBuffer, 0);
+        return true;
     }
 
     void VulkanSwapchain::present()
     {
         uint32_t currentFrameIndex = Renderer::getCurrentFrameIndex();
+        FrameContext& frame = m_Frames[currentFrameIndex];
 
-        std::vector<VkSemaphore> waitSemaphores = { m_ImageAvailableSemaphores[currentFrameIndex]};
-        std::vector<VkSemaphore> signalSemaphores = { m_RenderFinishedSemaphores[currentFrameIndex]};
-        std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        // Results of the frame's dispatches are consumed by the vertex input onwards.
+        std::vector<VkSemaphore> waitSemaphores;
+        std::vector<VkPipelineStageFlags> waitStages;
+        if (VkSemaphore computeFinished = submitCompute(currentFrameIndex))
+        {
+            waitSemaphores.push_back(computeFinished);
+            waitStages.push_back(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+                | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+        }
+
+        // Every frame advances the frame timeline, which other queues wait on (see VulkanDevice::getFrameTimeline).
+        // [NOTE] Values of binary semaphores in the same submission are ignored.
+        uint64_t frameValue = m_Device->getSubmittedFrameValue() + 1;
+        std::vector<VkSemaphore> signalSemaphores = { m_Device->getFrameTimeline() };
+        std::vector<uint64_t> signalValues = { frameValue };
+
+        // [NOTE] Headless frames acquire and present nothing, so the fence and the timeline are all they need.
+        if (!m_Headless)
+        {
+            waitSemaphores.push_back(frame.imageAvailableSemaphore);
+            waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+            signalSemaphores.push_back(m_RenderFinishedSemaphores[m_CurrentImageIndex]);
+            signalValues.push_back(0);
+        }
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size()),
+            .pSignalSemaphoreValues = signalValues.data(),
+        };
 
         VkSubmitInfo submitInfo{
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &timelineInfo,
             .waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size()),
             .pWaitSemaphores = waitSemaphores.data(),
             .pWaitDstStageMask = waitStages.data(),
             .commandBufferCount = 1,
-            .pCommandBuffers = &m_CommandBuffers[currentFrameIndex],
+            .pCommandBuffers = &frame.commandBuffer,
             .signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size()),
             .pSignalSemaphores = signalSemaphores.data()
         };
 
-        VK_CHECK(::vkQueueSubmit(m_Device->getGraphicsQueue(), 1, &submitInfo, m_InFlightFences[currentFrameIndex]));
+        VK_CHECK(::vkQueueSubmit(m_Device->getGraphicsQueue(), 1, &submitInfo, frame.inFlightFence));
+        m_Device->setSubmittedFrameValue(frameValue);
+
+        if (m_Headless)
+        {
+            return;
+        }
 
+        VkSemaphore renderFinished = m_RenderFinishedSemaphores[m_CurrentImageIndex];
         VkPresentInfoKHR presentInfo{
             .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
             .pNext = nullptr,
-            .waitSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size()),
-            .pWaitSemaphores = signalSemaphores.data(),
+            .waitSemaphoreCount = 1,
+            .pWaitSemaphores = &renderFinished,
             .swapchainCount = 1,
             .pSwapchains = &m_Swapchain,
             .pImageIndices = &m_CurrentImageIndex,
@@ -323,7 +560,24 @@ namespace Astranox
 
     VkCommandBuffer VulkanSwapchain::getCurrentCommandBuffer()
     {
-        return m_CommandBuffers[Renderer::getCurrentFrameIndex()];
+        return m_Frames[Renderer::getCurrentFrameIndex()].commandBuffer;
+    }
+
+    VkCommandBuffer VulkanSwapchain::getCurrentComputeCommandBuffer()
+    {
+        FrameContext& frame = m_Frames[Renderer::getCurrentFrameIndex()];
+
+        if (!frame.computeRecording)
+        {
+            VkCommandBufferBeginInfo beginInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+            };
+            VK_CHECK(::vkBeginCommandBuffer(frame.computeCommandBuffer, &beginInfo));
+            frame.computeRecording = true;
+        }
+
+        return frame.computeCommandBuffer;
     }
 
     void VulkanSwapchain::chooseSurfaceFormat()
@@ -425,7 +679,8 @@ namespace Astranox
             .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
             //.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL  // Use this if you want multisampling
-            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            // [NOTE] PRESENT_SRC_KHR requires the swapchain extension, which a headless device does not enable.
+            .finalLayout = m_Headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
         };
 
         VkAttachmentReference colorAttachmentRef{
@@ -527,14 +782,10 @@ namespace Astranox
         }
     }
 
-    void VulkanSwapchain::createSyncObjects()
+    void VulkanSwapchain::createFrameContexts()
     {
-        uint32_t framesInFlight = static_cast<uint32_t>(m_Images.size());
-
-        m_ImageAvailableSemaphores.resize(framesInFlight);
-        m_RenderFinishedSemaphores.resize(framesInFlight);
-
-        m_InFlightFences.resize(framesInFlight);
+        uint32_t framesInFlight = Renderer::getConfig().framesInFlight;
+        m_Frames.resize(framesInFlight);
 
         VkSemaphoreCreateInfo semaphoreInfo{
             .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
@@ -545,15 +796,116 @@ namespace Astranox
             .flags = VK_FENCE_CREATE_SIGNALED_BIT
         };
 
-        for (size_t i = 0; i < framesInFlight; i++)
+        std::vector<VkCommandBuffer> commandBuffers = m_Device->getCommandPool()->allocateCommandBuffers(framesInFlight);
+
+        // Compute >>>
+        VkCommandPoolCreateInfo computePoolInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+            .queueFamilyIndex = m_Device->getPhysicalDevice()->getQueueIndices().computeFamily.value(),
+        };
+        VK_CHECK(::vkCreateCommandPool(m_Device->getRaw(), &computePoolInfo, nullptr, &m_ComputeCommandPool));
+
+        VkCommandBufferAllocateInfo computeAllocInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = m_ComputeCommandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = framesInFlight,
+        };
+        std::vector<VkCommandBuffer> computeCommandBuffers(framesInFlight);
+        VK_CHECK(::vkAllocateCommandBuffers(m_Device->getRaw(), &computeAllocInfo, computeCommandBuffers.data()));
+        // <<< Compute
+
+        for (uint32_t i = 0; i < framesInFlight; i++)
         {
-            VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &m_ImageAvailableSemaphores[i]));
-            VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]));
+            FrameContext& frame = m_Frames[i];
+            frame.commandBuffer = commandBuffers[i];
+            frame.computeCommandBuffer = computeCommandBuffers[i];
 
-            VK_CHECK(::vkCreateFence(m_Device->getRaw(), &fenceInfo, nullptr, &m_InFlightFences[i]));
+            VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &frame.imageAvailableSemaphore));
+            VK_CHECK(::vkCreateFence(m_Device->getRaw(), &fenceInfo, nullptr, &frame.inFlightFence));
+
+            VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &frame.computeFinishedSemaphore));
         }
     }
 
+    void VulkanSwapchain::createImageSyncObjects()
+    {
+        uint32_t imageCount = static_cast<uint32_t>(m_Images.size());
+
+        VkSemaphoreCreateInfo semaphoreInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        };
+
+        // Headless frames are never presented, so they signal nothing.
+        if (!m_Headless)
+        {
+            m_RenderFinishedSemaphores.resize(imageCount);
+            for (uint32_t i = 0; i < imageCount; i++)
+            {
+                VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]));
+            }
+        }
+
+        m_ImageFences.assign(imageCount, VK_NULL_HANDLE);
+    }
+
+    void VulkanSwapchain::destroyImageSyncObjects()
+    {
+        // Presentation of the frames in flight may still wait on them.
+        for (auto semaphore : m_RenderFinishedSemaphores)
+        {
+            VulkanContext::get()->getDeletionQueue()->push([device = m_Device->getRaw(), semaphore]() {
+                ::vkDestroySemaphore(device, semaphore, nullptr);
+            });
+        }
+        m_RenderFinishedSemaphores.clear();
+
+        m_ImageFences.clear();
+    }
+
+    VkSemaphore VulkanSwapchain::submitCompute(uint32_t frameIndex)
+    {
+        FrameContext& frame = m_Frames[frameIndex];
+        if (!frame.computeRecording)
+        {
+            return VK_NULL_HANDLE;
+        }
+        frame.computeRecording = false;
+
+        VkCommandBuffer commandBuffer = frame.computeCommandBuffer;
+        VK_CHECK(::vkEndCommandBuffer(commandBuffer));
+
+        // The dispatches read buffers written by uploads and write buffers the previous frame may still read,
+        // so they wait on both the last upload batch (flushed before present) and the last submitted frame.
+        auto uploadManager = VulkanContext::get()->getUploadManager();
+        std::array<VkSemaphore, 2> waitSemaphores = { uploadManager->getTimeline(), m_Device->getFrameTimeline() };
+        std::array<uint64_t, 2> waitValues = { uploadManager->getSubmittedBatchID(), m_Device->getSubmittedFrameValue() };
+        std::array<VkPipelineStageFlags, 2> waitStages = { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT };
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size()),
+            .pWaitSemaphoreValues = waitValues.data(),
+        };
+
+        VkSubmitInfo submitInfo{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &timelineInfo,
+            .waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size()),
+            .pWaitSemaphores = waitSemaphores.data(),
+            .pWaitDstStageMask = waitStages.data(),
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &frame.computeFinishedSemaphore,
+        };
+        VK_CHECK(::vkQueueSubmit(m_Device->getComputeQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+
+        return frame.computeFinishedSemaphore;
+    }
+
     VkImageView VulkanSwapchain::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels)
     {
         VkImageView imageView;
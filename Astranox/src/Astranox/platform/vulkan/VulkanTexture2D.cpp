@@ -20,24 +20,6 @@ namespace Astranox
         VulkanMemoryAllocator allocator("VulkanTexture");
 
         // Texture image >>>
-        VkBufferCreateInfo stagingBufferCI{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = m_Buffer.size,
-            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        };
-
-        VkBuffer stagingBuffer;
-        VmaAllocation stagingBufferAllocation = allocator.createBuffer(
-            stagingBufferCI,
-            VMA_MEMORY_USAGE_CPU_TO_GPU,
-            stagingBuffer
-        );
-
-        void* dest = allocator.mapMemory<void>(stagingBufferAllocation);
-        std::memcpy(dest, m_Buffer.data, static_cast<size_t>(m_Buffer.size));
-        allocator.unmapMemory(stagingBufferAllocation);
-
         VkImageCreateInfo imageInfo{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .flags = 0,
@@ -64,31 +46,13 @@ namespace Astranox
             m_TextureImage
         );
 
-        allocator.transitionImageLayout(
-            m_TextureImage,
-            VK_FORMAT_R8G8B8A8_SRGB,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            m_TextureMipLevels
-        );
-
-        allocator.copyBufferToImage(
-            stagingBuffer,
-            m_TextureImage,
-            m_Width,
-            m_Height
-        );
-
-        //transitionImageLayout(
-        //    m_TextureImage,
-        //    VK_FORMAT_R8G8B8A8_SRGB,
-        //    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        //    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-        //);
-
-        generateMipmaps();
-
-        allocator.destroyBuffer(stagingBuffer, stagingBufferAllocation);
+        // [NOTE] The pixels are copied into the staging ring right away, so `m_Buffer` can be released
+        // as soon as this returns. The GPU work itself runs with the next upload batch.
+        auto uploadManager = VulkanContext::get()->getUploadManager();
+        uploadManager->uploadImage(m_TextureImage, m_Buffer.data, m_Buffer.size, m_Width, m_Height, m_TextureMipLevels);
+        m_UploadHandle = uploadManager->record([this](VkCommandBuffer commandBuffer) {
+            generateMipmaps(commandBuffer);
+        });
         // <<< Texture image
 
         // Texture image view >>>
@@ -129,6 +93,11 @@ namespace Astranox
             .imageView = m_TextureImageView,
             .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
         };
+
+        if (hasOwnID())
+        {
+            VulkanContext::get()->getBindlessTextureRegistry()->registerTexture(getID(), m_DescriptorImageInfo);
+        }
     }
 
     VulkanTexture2D::VulkanTexture2D(uint32_t width, uint32_t height, Buffer buffer)
@@ -144,24 +113,6 @@ namespace Astranox
         //m_Buffer.data = new uint8_t[m_Buffer.size];
         //memcpy(m_Buffer.data, buffer.data, m_Buffer.size);
 
-        VkBufferCreateInfo stagingBufferCI{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = m_Buffer.size,
-            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        };
-
-        VkBuffer stagingBuffer;
-        VmaAllocation stagingBufferAllocation = allocator.createBuffer(
-            stagingBufferCI,
-            VMA_MEMORY_USAGE_CPU_TO_GPU,
-            stagingBuffer
-        );
-
-        void* dest = allocator.mapMemory<void>(stagingBufferAllocation);
-        std::memcpy(dest, m_Buffer.data, static_cast<size_t>(m_Buffer.size));
-        allocator.unmapMemory(stagingBufferAllocation);
-
         VkImageCreateInfo imageInfo{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .flags = 0,
@@ -188,31 +139,11 @@ namespace Astranox
             m_TextureImage
         );
 
-        allocator.transitionImageLayout(
-            m_TextureImage,
-            VK_FORMAT_R8G8B8A8_SRGB,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            m_TextureMipLevels
-        );
-
-        allocator.copyBufferToImage(
-            stagingBuffer,
-            m_TextureImage,
-            m_Width,
-            m_Height
-        );
-
-        //transitionImageLayout(
-        //    m_TextureImage,
-        //    VK_FORMAT_R8G8B8A8_SRGB,
-        //    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        //    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-        //);
-
-        generateMipmaps();
-
-        allocator.destroyBuffer(stagingBuffer, stagingBufferAllocation);
+        auto uploadManager = VulkanContext::get()->getUploadManager();
+        uploadManager->uploadImage(m_TextureImage, m_Buffer.data, m_Buffer.size, m_Width, m_Height, m_TextureMipLevels);
+        m_UploadHandle = uploadManager->record([this](VkCommandBuffer commandBuffer) {
+            generateMipmaps(commandBuffer);
+        });
         // <<< Texture image
 
         // Texture image view >>>
@@ -252,16 +183,28 @@ namespace Astranox
             .imageView = m_TextureImageView,
             .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
         };
+
+        if (hasOwnID())
+        {
+            VulkanContext::get()->getBindlessTextureRegistry()->registerTexture(getID(), m_DescriptorImageInfo);
+        }
     }
 
     VulkanTexture2D::~VulkanTexture2D()
     {
         VkDevice device = VulkanContext::get()->getDevice()->getRaw();
 
-        VulkanMemoryAllocator allocator("VulkanTexture");
-        ::vkDestroySampler(device, m_TextureSampler, nullptr);
-        ::vkDestroyImageView(device, m_TextureImageView, nullptr);
-        allocator.destroyImage(m_TextureImage, m_TextureImageAllocation);
+        VulkanContext::get()->getDeletionQueue()->push(
+            [device, image = m_TextureImage, allocation = m_TextureImageAllocation, imageView = m_TextureImageView, sampler = m_TextureSampler, uploadHandle = m_UploadHandle]() {
+                // The upload into this image may still be pending.
+                VulkanContext::get()->getUploadManager()->wait(uploadHandle);
+
+                VulkanMemoryAllocator allocator("VulkanTexture");
+                ::vkDestroySampler(device, sampler, nullptr);
+                ::vkDestroyImageView(device, imageView, nullptr);
+                allocator.destroyImage(image, allocation);
+            }
+        );
     }
 
     void VulkanTexture2D::loadFromFile(const std::filesystem::path& path)
@@ -279,14 +222,8 @@ namespace Astranox
         m_Channels = texChannels;
     }
 
-    void VulkanTexture2D::generateMipmaps()
+    void VulkanTexture2D::generateMipmaps(VkCommandBuffer blitCmdBuffer)
     {
-        auto device = VulkanContext::get()->getDevice();
-        auto commandPool = device->getCommandPool();
-
-        VkCommandBuffer blitCmdBuffer = commandPool->allocateCommandBuffer();
-        commandPool->beginOneTimeBuffer(blitCmdBuffer);
-
         VkImageMemoryBarrier barrier{
             .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
@@ -384,8 +321,6 @@ namespace Astranox
             0, nullptr,
             1, &barrier
         );
-
-        commandPool->endOneTimeBuffer(blitCmdBuffer);
     }
 
     uint32_t VulkanTexture2D::calculateMipLevels()
@@ -35,9 +35,11 @@ namespace Astranox
 
     VulkanUniformBuffer::~VulkanUniformBuffer()
     {
-        VulkanMemoryAllocator allocator("VulkanUniformBuffer");
-        allocator.unmapMemory(m_UniformBufferAllocation);
-        allocator.destroyBuffer(m_UniformBuffer, m_UniformBufferAllocation);
+        VulkanContext::get()->getDeletionQueue()->push([buffer = m_UniformBuffer, allocation = m_UniformBufferAllocation]() {
+            VulkanMemoryAllocator allocator("VulkanUniformBuffer");
+            allocator.unmapMemory(allocation);
+            allocator.destroyBuffer(buffer, allocation);
+        });
     }
 
     void VulkanUniformBuffer::setData(const void* data, uint32_t bytes, uint32_t offset)
@@ -0,0 +1,620 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanUploadManager.hpp"
+#include "Astranox/platform/vulkan/VulkanMemoryAllocator.hpp"
+#include "Astranox/platform/vulkan/VulkanUtils.hpp"
+
+namespace Astranox
+{
+    static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    VulkanUploadManager::VulkanUploadManager(Ref<VulkanDevice> device)
+        : m_Device(device)
+    {
+        auto& queueFamilyIndices = m_Device->getPhysicalDevice()->getQueueIndices();
+        m_GraphicsFamily = queueFamilyIndices.graphicsFamily.value();
+        m_TransferFamily = queueFamilyIndices.transferFamily.value();
+        m_DedicatedTransfer = m_Device->hasDedicatedTransferQueue();
+
+        AST_CORE_INFO("Uploads run on {0}.", m_DedicatedTransfer ? "a dedicated transfer queue" : "the graphics queue");
+
+        auto createCommandPool = [this](uint32_t queueFamily) {
+            VkCommandPoolCreateInfo poolInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                .queueFamilyIndex = queueFamily,
+            };
+            VkCommandPool commandPool = VK_NULL_HANDLE;
+            VK_CHECK(::vkCreateCommandPool(m_Device->getRaw(), &poolInfo, nullptr, &commandPool));
+            return commandPool;
+        };
+
+        VkSemaphoreTypeCreateInfo timelineInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+            .initialValue = 0,
+        };
+        VkSemaphoreCreateInfo semaphoreInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = &timelineInfo,
+        };
+        VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &m_Timeline));
+
+        m_CommandPool = createCommandPool(m_GraphicsFamily);
+        if (m_DedicatedTransfer)
+        {
+            m_TransferCommandPool = createCommandPool(m_TransferFamily);
+        }
+
+        // Staging ring >>>
+        // [NOTE] Buffer-to-image copies need offsets aligned to the texel size, which 16 bytes covers for every color format.
+        VkDeviceSize optimalAlignment = m_Device->getPhysicalDevice()->getProperties().limits.optimalBufferCopyOffsetAlignment;
+        m_StagingAlignment = std::max<VkDeviceSize>(m_StagingAlignment, optimalAlignment);
+
+        VulkanMemoryAllocator allocator("VulkanUploadManager");
+
+        VkBufferCreateInfo stagingBufferCI{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = s_StagingRingSize,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        };
+        // [NOTE] CPU_ONLY memory is host-coherent, so writes into the ring never need an explicit flush.
+        m_StagingAllocation = allocator.createBuffer(
+            stagingBufferCI,
+            VMA_MEMORY_USAGE_CPU_ONLY,
+            m_StagingBuffer
+        );
+        m_StagingData = allocator.mapMemory<uint8_t>(m_StagingAllocation);
+        // <<< Staging ring
+    }
+
+    void VulkanUploadManager::destroy()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // [NOTE] An unsubmitted batch may reference resources that have already been destroyed, so it is dropped.
+        if (m_Recording)
+        {
+            if (m_DedicatedTransfer)
+            {
+                VK_CHECK(::vkEndCommandBuffer(m_RecordingBatch.transferCommandBuffer));
+            }
+            VK_CHECK(::vkEndCommandBuffer(m_RecordingBatch.commandBuffer));
+            m_Recording = false;
+            m_FreeBatches.push_back(std::move(m_RecordingBatch));
+        }
+
+        while (!m_InFlightBatches.empty())
+        {
+            waitOldestLocked();
+        }
+
+        VulkanMemoryAllocator allocator("VulkanUploadManager");
+        for (Batch& batch : m_FreeBatches)
+        {
+            for (auto& [buffer, allocation] : batch.dedicatedStagingBuffers)
+            {
+                allocator.destroyBuffer(buffer, allocation);
+            }
+            ::vkDestroyFence(m_Device->getRaw(), batch.fence, nullptr);
+            if (batch.transferSemaphore)
+            {
+                ::vkDestroySemaphore(m_Device->getRaw(), batch.transferSemaphore, nullptr);
+            }
+        }
+        m_FreeBatches.clear();
+
+        // Command buffers are freed along with their pools.
+        ::vkDestroyCommandPool(m_Device->getRaw(), m_CommandPool, nullptr);
+        m_CommandPool = VK_NULL_HANDLE;
+        if (m_TransferCommandPool)
+        {
+            ::vkDestroyCommandPool(m_Device->getRaw(), m_TransferCommandPool, nullptr);
+            m_TransferCommandPool = VK_NULL_HANDLE;
+        }
+
+        allocator.unmapMemory(m_StagingAllocation);
+        allocator.destroyBuffer(m_StagingBuffer, m_StagingAllocation);
+        m_StagingData = nullptr;
+
+        ::vkDestroySemaphore(m_Device->getRaw(), m_Timeline, nullptr);
+        m_Timeline = VK_NULL_HANDLE;
+    }
+
+    UploadHandle VulkanUploadManager::uploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize bytes, VkDeviceSize dstOffset, VkSharingMode sharingMode)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto [srcBuffer, srcOffset] = allocateStaging(data, bytes);
+        Batch& batch = getRecordingBatch();
+
+        // Write-after-read against the frames submitted so far.
+        if (!batch.waitsForFrames)
+        {
+            batch.waitsForFrames = true;
+
+            // [NOTE] On the graphics queue, submission order plus an execution dependency is enough.
+            //      A dedicated transfer queue waits on the frame timeline instead, see flushLocked().
+            if (!m_DedicatedTransfer)
+            {
+                ::vkCmdPipelineBarrier(
+                    batch.transferCommandBuffer,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    0,
+                    0, nullptr,
+                    0, nullptr,
+                    0, nullptr
+                );
+            }
+        }
+
+        VkBufferCopy copyRegion{
+            .srcOffset = srcOffset,
+            .dstOffset = dstOffset,
+            .size = bytes
+        };
+        ::vkCmdCopyBuffer(batch.transferCommandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+
+        if (m_DedicatedTransfer && sharingMode == VK_SHARING_MODE_EXCLUSIVE)
+        {
+            // Hand the buffer over to the graphics family: released after the copy, acquired once the semaphore is waited on.
+            VkBufferMemoryBarrier ownershipBarrier{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = 0,
+                .srcQueueFamilyIndex = m_TransferFamily,
+                .dstQueueFamilyIndex = m_GraphicsFamily,
+                .buffer = dstBuffer,
+                .offset = dstOffset,
+                .size = bytes
+            };
+            ::vkCmdPipelineBarrier(
+                batch.transferCommandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0,
+                0, nullptr,
+                1, &ownershipBarrier,
+                0, nullptr
+            );
+
+            ownershipBarrier.srcAccessMask = 0;
+            ownershipBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+            ::vkCmdPipelineBarrier(
+                batch.commandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                0, nullptr,
+                1, &ownershipBarrier,
+                0, nullptr
+            );
+        }
+
+        return { batch.id };
+    }
+
+    UploadHandle VulkanUploadManager::uploadImage(VkImage dstImage, const void* data, VkDeviceSize bytes, uint32_t width, uint32_t height, uint32_t mipLevels)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto [srcBuffer, srcOffset] = allocateStaging(data, bytes);
+        Batch& batch = getRecordingBatch();
+
+        VkImageMemoryBarrier barrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = 0,
+            .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = dstImage,
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            }
+        };
+        ::vkCmdPipelineBarrier(
+            batch.transferCommandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0,
+            0, nullptr,
+            0, nullptr,
+            1, &barrier
+        );
+
+        VkBufferImageCopy region{
+            .bufferOffset = srcOffset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            },
+            .imageOffset = { 0, 0, 0 },
+            .imageExtent = { width, height, 1 }
+        };
+        ::vkCmdCopyBufferToImage(
+            batch.transferCommandBuffer,
+            srcBuffer,
+            dstImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &region
+        );
+
+        if (m_DedicatedTransfer)
+        {
+            // Hand the image over to the graphics family, which records the mip blits. The layout stays the same.
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = m_TransferFamily;
+            barrier.dstQueueFamilyIndex = m_GraphicsFamily;
+            ::vkCmdPipelineBarrier(
+                batch.transferCommandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            ::vkCmdPipelineBarrier(
+                batch.commandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+        }
+
+        return { batch.id };
+    }
+
+    UploadHandle VulkanUploadManager::record(const std::function<void(VkCommandBuffer)>& commands)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        Batch& batch = getRecordingBatch();
+        commands(batch.commandBuffer);
+
+        return { batch.id };
+    }
+
+    void VulkanUploadManager::flush()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        flushLocked();
+    }
+
+    bool VulkanUploadManager::isComplete(UploadHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        retireLocked();
+        return handle.batch <= m_CompletedBatchID;
+    }
+
+    void VulkanUploadManager::wait(UploadHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (handle.batch <= m_CompletedBatchID)
+        {
+            return;
+        }
+
+        if (m_Recording && handle.batch == m_RecordingBatch.id)
+        {
+            flushLocked();
+        }
+
+        while (m_CompletedBatchID < handle.batch && !m_InFlightBatches.empty())
+        {
+            waitOldestLocked();
+        }
+    }
+
+    void VulkanUploadManager::retire()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        retireLocked();
+    }
+
+    uint64_t VulkanUploadManager::getSubmittedBatchID()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_SubmittedBatchID;
+    }
+
+    std::pair<VkBuffer, VkDeviceSize> VulkanUploadManager::allocateStaging(const void* data, VkDeviceSize bytes)
+    {
+        if (bytes > s_DedicatedStagingThreshold)
+        {
+            // [NOTE] Huge uploads would drain the ring on their own, so they get a staging buffer that dies with the batch.
+            VulkanMemoryAllocator allocator("VulkanUploadManager");
+
+            VkBufferCreateInfo stagingBufferCI{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                .size = bytes,
+                .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            };
+
+            VkBuffer stagingBuffer;
+            VmaAllocation stagingAllocation = allocator.createBuffer(
+                stagingBufferCI,
+                VMA_MEMORY_USAGE_CPU_ONLY,
+                stagingBuffer
+            );
+
+            void* dest = allocator.mapMemory<void>(stagingAllocation);
+            std::memcpy(dest, data, static_cast<size_t>(bytes));
+            allocator.unmapMemory(stagingAllocation);
+
+            getRecordingBatch().dedicatedStagingBuffers.emplace_back(stagingBuffer, stagingAllocation);
+            return { stagingBuffer, 0 };
+        }
+
+        VkDeviceSize offset = 0;
+        while (!tryAllocateFromRing(bytes, offset))
+        {
+            // The ring is full: make room by waiting for the oldest batch, submitting the current one if it holds everything.
+            if (m_InFlightBatches.empty())
+            {
+                AST_CORE_ASSERT(m_Recording, "Staging ring is exhausted, but no batch owns any of it!");
+                flushLocked();
+            }
+            waitOldestLocked();
+        }
+
+        std::memcpy(m_StagingData + offset, data, static_cast<size_t>(bytes));
+
+        getRecordingBatch().ringHead = m_RingHead;
+        return { m_StagingBuffer, offset };
+    }
+
+    bool VulkanUploadManager::tryAllocateFromRing(VkDeviceSize bytes, VkDeviceSize& offset)
+    {
+        if (m_RingHead == m_RingTail)
+        {
+            // Empty, so start over from the beginning to keep the free range contiguous.
+            m_RingHead = m_RingTail = 0;
+        }
+
+        VkDeviceSize alignedHead = alignUp(m_RingHead, m_StagingAlignment);
+
+        if (m_RingHead >= m_RingTail)
+        {
+            // Free space is [head, size) followed by [0, tail).
+            if (alignedHead + bytes <= s_StagingRingSize)
+            {
+                offset = alignedHead;
+                m_RingHead = alignedHead + bytes;
+                return true;
+            }
+            if (bytes < m_RingTail)
+            {
+                offset = 0;
+                m_RingHead = bytes;
+                return true;
+            }
+            return false;
+        }
+
+        // Free space is [head, tail).
+        if (alignedHead + bytes < m_RingTail)
+        {
+            offset = alignedHead;
+            m_RingHead = alignedHead + bytes;
+            return true;
+        }
+        return false;
+    }
+
+    VulkanUploadManager::Batch& VulkanUploadManager::getRecordingBatch()
+    {
+        if (m_Recording)
+        {
+            return m_RecordingBatch;
+        }
+
+        if (!m_FreeBatches.empty())
+        {
+            m_RecordingBatch = std::move(m_FreeBatches.back());
+            m_FreeBatches.pop_back();
+        }
+        else
+        {
+            m_RecordingBatch = {};
+            m_RecordingBatch.commandBuffer = allocateCommandBuffer(m_CommandPool);
+            m_RecordingBatch.transferCommandBuffer = m_RecordingBatch.commandBuffer;
+
+            if (m_DedicatedTransfer)
+            {
+                m_RecordingBatch.transferCommandBuffer = allocateCommandBuffer(m_TransferCommandPool);
+
+                VkSemaphoreCreateInfo semaphoreInfo{
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+                };
+                VK_CHECK(::vkCreateSemaphore(m_Device->getRaw(), &semaphoreInfo, nullptr, &m_RecordingBatch.transferSemaphore));
+            }
+
+            VkFenceCreateInfo fenceInfo{
+                .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+                .flags = 0,
+            };
+            VK_CHECK(::vkCreateFence(m_Device->getRaw(), &fenceInfo, nullptr, &m_RecordingBatch.fence));
+        }
+
+        m_RecordingBatch.id = m_NextBatchID++;
+        m_RecordingBatch.ringHead = m_RingHead;
+        m_RecordingBatch.waitsForFrames = false;
+
+        VkCommandBufferBeginInfo beginInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+        };
+        VK_CHECK(::vkBeginCommandBuffer(m_RecordingBatch.commandBuffer, &beginInfo));
+        if (m_DedicatedTransfer)
+        {
+            VK_CHECK(::vkBeginCommandBuffer(m_RecordingBatch.transferCommandBuffer, &beginInfo));
+        }
+
+        m_Recording = true;
+        return m_RecordingBatch;
+    }
+
+    VkCommandBuffer VulkanUploadManager::allocateCommandBuffer(VkCommandPool commandPool)
+    {
+        VkCommandBufferAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = commandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1,
+        };
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VK_CHECK(::vkAllocateCommandBuffers(m_Device->getRaw(), &allocInfo, &commandBuffer));
+        return commandBuffer;
+    }
+
+    void VulkanUploadManager::flushLocked()
+    {
+        if (!m_Recording)
+        {
+            return;
+        }
+
+        // [NOTE] The graphics half of a batch is submitted ahead of the frames that use its resources,
+        // so submission order plus one memory barrier is enough to make its writes visible to them.
+        VkMemoryBarrier barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT,
+        };
+        ::vkCmdPipelineBarrier(
+            m_RecordingBatch.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr
+        );
+
+        VK_CHECK(::vkEndCommandBuffer(m_RecordingBatch.commandBuffer));
+
+        // The graphics half runs last, so it signals the timeline for the whole batch.
+        uint64_t batchID = m_RecordingBatch.id;
+        VkTimelineSemaphoreSubmitInfo batchTimelineInfo{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .signalSemaphoreValueCount = 1,
+            .pSignalSemaphoreValues = &batchID,
+        };
+
+        VkSubmitInfo submitInfo{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &batchTimelineInfo,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &m_RecordingBatch.commandBuffer,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &m_Timeline,
+        };
+
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        if (m_DedicatedTransfer)
+        {
+            VK_CHECK(::vkEndCommandBuffer(m_RecordingBatch.transferCommandBuffer));
+
+            VkSemaphore frameTimeline = m_Device->getFrameTimeline();
+            uint64_t frameValue = m_Device->getSubmittedFrameValue();
+            VkPipelineStageFlags frameWaitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            VkTimelineSemaphoreSubmitInfo timelineInfo{
+                .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                .waitSemaphoreValueCount = 1,
+                .pWaitSemaphoreValues = &frameValue,
+            };
+
+            VkSubmitInfo transferSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                .commandBufferCount = 1,
+                .pCommandBuffers = &m_RecordingBatch.transferCommandBuffer,
+                .signalSemaphoreCount = 1,
+                .pSignalSemaphores = &m_RecordingBatch.transferSemaphore,
+            };
+            if (m_RecordingBatch.waitsForFrames)
+            {
+                transferSubmitInfo.pNext = &timelineInfo;
+                transferSubmitInfo.waitSemaphoreCount = 1;
+                transferSubmitInfo.pWaitSemaphores = &frameTimeline;
+                transferSubmitInfo.pWaitDstStageMask = &frameWaitStage;
+            }
+            VK_CHECK(::vkQueueSubmit(m_Device->getTransferQueue(), 1, &transferSubmitInfo, VK_NULL_HANDLE));
+
+            // The acquire half only waits on the copies; earlier frames keep rendering meanwhile.
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &m_RecordingBatch.transferSemaphore;
+            submitInfo.pWaitDstStageMask = &waitStage;
+        }
+
+        // [NOTE] The graphics submission waits on the transfer one, so its fence covers the whole batch.
+        VK_CHECK(::vkQueueSubmit(m_Device->getGraphicsQueue(), 1, &submitInfo, m_RecordingBatch.fence));
+        m_SubmittedBatchID = batchID;
+
+        m_InFlightBatches.push_back(std::move(m_RecordingBatch));
+        m_Recording = false;
+    }
+
+    void VulkanUploadManager::retireLocked()
+    {
+        VulkanMemoryAllocator allocator("VulkanUploadManager");
+
+        while (!m_InFlightBatches.empty())
+        {
+            Batch& batch = m_InFlightBatches.front();
+            if (::vkGetFenceStatus(m_Device->getRaw(), batch.fence) != VK_SUCCESS)
+            {
+                break;
+            }
+
+            for (auto& [buffer, allocation] : batch.dedicatedStagingBuffers)
+            {
+                allocator.destroyBuffer(buffer, allocation);
+            }
+            batch.dedicatedStagingBuffers.clear();
+
+            VK_CHECK(::vkResetFences(m_Device->getRaw(), 1, &batch.fence));
+            VK_CHECK(::vkResetCommandBuffer(batch.commandBuffer, 0));
+            if (m_DedicatedTransfer)
+            {
+                VK_CHECK(::vkResetCommandBuffer(batch.transferCommandBuffer, 0));
+            }
+
+            m_RingTail = batch.ringHead;
+            m_CompletedBatchID = batch.id;
+
+            m_FreeBatches.push_back(std::move(batch));
+            m_InFlightBatches.pop_front();
+        }
+    }
+
+    void VulkanUploadManager::waitOldestLocked()
+    {
+        AST_CORE_ASSERT(!m_InFlightBatches.empty(), "No upload batch in flight!");
+
+        VkFence fence = m_InFlightBatches.front().fence;
+        VK_CHECK(::vkWaitForFences(m_Device->getRaw(), 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+        retireLocked();
+    }
+}
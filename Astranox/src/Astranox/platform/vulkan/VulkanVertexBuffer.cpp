@@ -23,6 +23,9 @@ namespace Astranox
             VMA_MEMORY_USAGE_CPU_TO_GPU,
             m_VertexBuffer
         );
+
+        // [NOTE] Dynamic vertex buffers are rewritten every frame, so they stay mapped for their whole lifetime.
+        m_MappedVertexBuffer = allocator.mapMemory<void>(m_VertexBufferAllocation);
     }
 
     VulkanVertexBuffer::VulkanVertexBuffer(void* data, uint32_t bytes)
@@ -31,25 +34,6 @@ namespace Astranox
 
         VulkanMemoryAllocator allocator("VulkanVertexBuffer");
 
-        VkBufferCreateInfo stagingBufferCI{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = bytes,
-            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        };
-
-        VkBuffer stagingBuffer;
-        VmaAllocation stagingBufferMemory = allocator.createBuffer(
-            stagingBufferCI,
-            VMA_MEMORY_USAGE_CPU_TO_GPU,
-            stagingBuffer
-        );
-
-        // Upload data to staging buffer
-        void* dest = allocator.mapMemory<void>(stagingBufferMemory);
-        std::memcpy(dest, data, bytes);
-        allocator.unmapMemory(stagingBufferMemory);
-
         VkBufferCreateInfo vertexBufferCI{
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .size = bytes,
@@ -63,22 +47,37 @@ namespace Astranox
             m_VertexBuffer
         );
 
-        allocator.copyBuffer(stagingBuffer, m_VertexBuffer, bytes);
-
-        allocator.destroyBuffer(stagingBuffer, stagingBufferMemory);
+        m_UploadHandle = VulkanContext::get()->getUploadManager()->uploadBuffer(m_VertexBuffer, data, bytes);
     }
 
     VulkanVertexBuffer::~VulkanVertexBuffer()
     {
-        VulkanMemoryAllocator allocator("VulkanVertexBuffer");
-        allocator.destroyBuffer(m_VertexBuffer, m_VertexBufferAllocation);
+        VulkanContext::get()->getDeletionQueue()->push(
+            [buffer = m_VertexBuffer, allocation = m_VertexBufferAllocation, mapped = m_MappedVertexBuffer != nullptr, uploadHandle = m_UploadHandle]() {
+                // The copy into this buffer may still be pending.
+                VulkanContext::get()->getUploadManager()->wait(uploadHandle);
+
+                VulkanMemoryAllocator allocator("VulkanVertexBuffer");
+                if (mapped)
+                {
+                    allocator.unmapMemory(allocation);
+                }
+                allocator.destroyBuffer(buffer, allocation);
+            }
+        );
     }
 
     void VulkanVertexBuffer::setData(const void* data, uint32_t bytes)
+    {
+        AST_CORE_ASSERT(m_MappedVertexBuffer, "Static vertex buffers cannot be updated!");
+
+        std::memcpy(m_MappedVertexBuffer, data, bytes);
+        flush(bytes);
+    }
+
+    void VulkanVertexBuffer::flush(uint32_t bytes, uint32_t offset)
     {
         VulkanMemoryAllocator allocator("VulkanVertexBuffer");
-        void* dest = allocator.mapMemory<void>(m_VertexBufferAllocation);
-        std::memcpy(dest, data, bytes);
-        allocator.unmapMemory(m_VertexBufferAllocation);
+        allocator.flushMemory(m_VertexBufferAllocation, offset, bytes);
     }
 }
@@ -0,0 +1,18 @@
+#include "pch.hpp"
+#include "Astranox/platform/vulkan/VulkanVertexBufferArray.hpp"
+
+#include "Astranox/rendering/Renderer.hpp"
+
+namespace Astranox
+{
+    VulkanVertexBufferArray::VulkanVertexBufferArray(uint32_t bytes)
+    {
+        uint32_t framesInFlight = Renderer::getConfig().framesInFlight;
+        m_VertexBuffers.resize(framesInFlight);
+
+        for (uint32_t i = 0; i < framesInFlight; i++)
+        {
+            m_VertexBuffers[i] = VertexBuffer::create(bytes);
+        }
+    }
+}
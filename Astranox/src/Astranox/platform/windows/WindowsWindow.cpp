@@ -14,7 +14,7 @@ namespace Astranox
         m_Data.title = spec.title;
         m_Data.width = static_cast<int>(spec.width);
         m_Data.height = static_cast<int>(spec.height);
-        m_Data.vsync = spec.vsync;
+        m_Data.presentPolicy = spec.presentPolicy;
     }
 
     void WindowsWindow::init()
@@ -51,8 +51,6 @@ namespace Astranox
         //::glfwMakeContextCurrent(m_Window);
         ::glfwSetWindowUserPointer(m_Handle, &m_Data);
 
-        this->setVSync(m_Data.vsync);
-
         // Set GLFW callbacks >>>
         ::glfwSetWindowSizeCallback(m_Handle, [](GLFWwindow* window, int width, int height)
         {
@@ -159,16 +157,16 @@ namespace Astranox
         swapchain->resize(width, height);
     }
 
-    void WindowsWindow::beginFrame()
+    bool WindowsWindow::beginFrame()
     {
         // I don't like it...
-        m_Context.as<VulkanContext>()->getSwapchain()->beginFrame();
+        return m_Context.as<VulkanContext>()->getSwapchain()->beginFrame();
     }
 
-    void WindowsWindow::setVSync(bool enable)
+    void WindowsWindow::setPresentPolicy(PresentPolicy policy)
     {
-        //::glfwSwapInterval(enable ? 1 : 0);  // [NOTE] 0: disable, 1: enable (vsync)
-        m_Data.vsync = enable;
+        m_Data.presentPolicy = policy;
+        m_Context.as<VulkanContext>()->getSwapchain()->setPresentPolicy(policy);
     }
 
     void WindowsWindow::pollEvents()
@@ -5,12 +5,12 @@
 
 namespace Astranox
 {
-    Ref<GraphicsContext> GraphicsContext::create()
+    Ref<GraphicsContext> GraphicsContext::create(bool headless)
     {
         switch (RendererAPI::getType())
         {
             case RendererAPI::Type::None:  { AST_CORE_ASSERT(false, "RendererAPI::None is not supported!"); break; }
-            case RendererAPI::Type::Vulkan: { return Ref<VulkanContext>::create(); }
+            case RendererAPI::Type::Vulkan: { return Ref<VulkanContext>::create(headless); }
         }
 
         AST_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -0,0 +1,136 @@
+#include "pch.hpp"
+#include "Astranox/rendering/QuadKernels.hpp"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define AST_QUAD_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define AST_QUAD_KERNEL_SSE2
+#endif
+
+namespace Astranox
+{
+    void QuadStreams::resize(size_t count)
+    {
+        positionX.resize(count);
+        positionY.resize(count);
+        positionZ.resize(count);
+        halfWidth.resize(count);
+        halfHeight.resize(count);
+        sin.resize(count);
+        cos.resize(count);
+    }
+
+    namespace QuadKernels
+    {
+        /*
+         * [NOTE] With the half extents (hx, hy) and the rotation (s, c), the corners relative to the center are
+         *  (-a + d, -b - e), (a + d, b - e), (a - d, b + e), (-a - d, -b + e)
+         * where a = c * hx, b = s * hx, d = s * hy, e = c * hy.
+         * This replaces translate * rotate * scale and four mat4 * vec4 products per quad.
+         */
+
+        static inline void writeCorner(void* dst, size_t stride, size_t corner, float x, float y, float z)
+        {
+            float* out = reinterpret_cast<float*>(static_cast<uint8_t*>(dst) + corner * stride);
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+        }
+
+        void computeCornersScalar(const QuadStreams& quads, size_t first, size_t count, void* dst, size_t stride)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t q = first + i;
+
+                float px = quads.positionX[q];
+                float py = quads.positionY[q];
+                float pz = quads.positionZ[q];
+
+                float a = quads.cos[q] * quads.halfWidth[q];
+                float b = quads.sin[q] * quads.halfWidth[q];
+                float d = quads.sin[q] * quads.halfHeight[q];
+                float e = quads.cos[q] * quads.halfHeight[q];
+
+                writeCorner(dst, stride, 4 * i + 0, px - a + d, py - b - e, pz);
+                writeCorner(dst, stride, 4 * i + 1, px + a + d, py + b - e, pz);
+                writeCorner(dst, stride, 4 * i + 2, px + a - d, py + b + e, pz);
+                writeCorner(dst, stride, 4 * i + 3, px - a - d, py - b + e, pz);
+            }
+        }
+
+#if defined(AST_QUAD_KERNEL_AVX)
+        static constexpr size_t s_Width = 8;
+        using Vec = __m256;
+        static inline Vec load(const float* p) { return _mm256_loadu_ps(p); }
+        static inline void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+        static inline Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+        static inline Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+        static inline Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+#elif defined(AST_QUAD_KERNEL_SSE2)
+        static constexpr size_t s_Width = 4;
+        using Vec = __m128;
+        static inline Vec load(const float* p) { return _mm_loadu_ps(p); }
+        static inline void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+        static inline Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+        static inline Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+        static inline Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+#endif
+
+        void computeCorners(const QuadStreams& quads, size_t first, size_t count, void* dst, size_t stride)
+        {
+#if defined(AST_QUAD_KERNEL_AVX) || defined(AST_QUAD_KERNEL_SSE2)
+            size_t i = 0;
+            for (; i + s_Width <= count; i += s_Width)
+            {
+                size_t q = first + i;
+
+                Vec px = load(&quads.positionX[q]);
+                Vec py = load(&quads.positionY[q]);
+                Vec hx = load(&quads.halfWidth[q]);
+                Vec hy = load(&quads.halfHeight[q]);
+                Vec s = load(&quads.sin[q]);
+                Vec c = load(&quads.cos[q]);
+
+                Vec a = mul(c, hx);
+                Vec b = mul(s, hx);
+                Vec d = mul(s, hy);
+                Vec e = mul(c, hy);
+
+                // x and y of the 4 corners of each quad in the register
+                alignas(32) float xs[4][s_Width];
+                alignas(32) float ys[4][s_Width];
+                store(xs[0], add(sub(px, a), d));
+                store(ys[0], sub(sub(py, b), e));
+                store(xs[1], add(add(px, a), d));
+                store(ys[1], sub(add(py, b), e));
+                store(xs[2], sub(add(px, a), d));
+                store(ys[2], add(add(py, b), e));
+                store(xs[3], sub(sub(px, a), d));
+                store(ys[3], add(sub(py, b), e));
+
+                // Scatter back to the interleaved vertex layout
+                for (size_t k = 0; k < s_Width; ++k)
+                {
+                    float pz = quads.positionZ[q + k];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        writeCorner(dst, stride, 4 * (i + k) + j, xs[j][k], ys[j][k], pz);
+                    }
+                }
+            }
+
+            // Remainder
+            if (i < count)
+            {
+                uint8_t* remainderDst = static_cast<uint8_t*>(dst) + 4 * i * stride;
+                computeCornersScalar(quads, first + i, count - i, remainderDst, stride);
+            }
+#else
+            computeCornersScalar(quads, first, count, dst, stride);
+#endif
+        }
+    }
+}
@@ -8,6 +8,9 @@
 namespace Astranox
 {
     static RendererConfig s_RendererConfig;
+    static ShaderLibrary s_ShaderLibrary;
+    static PipelineLibrary s_PipelineLibrary;
+    static std::unique_ptr<ThreadPool> s_ThreadPool = nullptr;
 
     static RendererAPI* initRendererAPI()
     {
@@ -23,12 +26,13 @@ namespace Astranox
 
     void Renderer::init()
     {
-        s_RendererConfig.framesInFlight = VulkanContext::get()->getSwapchain()->getImageCount();
+        s_ThreadPool = std::make_unique<ThreadPool>();
 
         // Initialize renderer api
         s_RendererAPI = initRendererAPI();
 
         // Load shaders
+        s_ShaderLibrary.setHotReload(s_RendererConfig.shaderHotReload);
 
         // Load textures
         constexpr uint32_t whiteTextureData = 0xffffffff;
@@ -37,9 +41,13 @@ namespace Astranox
 
     void Renderer::shutdown()
     {
+        s_PipelineLibrary.clear();
+        s_ShaderLibrary.clear();
         s_WhiteTexture = nullptr;
 
         delete s_RendererAPI;
+
+        s_ThreadPool.reset();
     }
 
     uint32_t Renderer::getCurrentFrameIndex()
@@ -52,8 +60,16 @@ namespace Astranox
         return s_RendererConfig;
     }
 
+    void Renderer::setConfig(const RendererConfig& config)
+    {
+        AST_CORE_ASSERT(config.framesInFlight > 0, "At least one frame in flight is required!");
+        s_RendererConfig = config;
+    }
+
     void Renderer::beginFrame()
     {
+        s_ShaderLibrary.update();
+
         s_RendererAPI->beginFrame();
     }
 
@@ -77,16 +93,52 @@ namespace Astranox
         s_RendererAPI->renderGeometry(commandBuffer, pipeline, dm, vertexBuffer, indexBuffer, indexCount);
     }
 
+    void Renderer::renderInstanced(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline, Ref<VulkanDescriptorManager> dm, Ref<VertexBuffer> vertexBuffer, Ref<VertexBuffer> instanceBuffer, Ref<IndexBuffer> indexBuffer, uint32_t indexCount, uint32_t instanceCount)
+    {
+        s_RendererAPI->renderInstanced(commandBuffer, pipeline, dm, vertexBuffer, instanceBuffer, indexBuffer, indexCount, instanceCount);
+    }
+
     void Renderer::renderMesh(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline, Mesh& mesh, uint32_t instanceCount)
     {
         s_RendererAPI->renderMesh(commandBuffer, pipeline, mesh, instanceCount);
     }
 
+    void Renderer::pushConstants(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline, const void* data, uint32_t size, uint32_t offset)
+    {
+        s_RendererAPI->pushConstants(commandBuffer, pipeline, data, size, offset);
+    }
+
+    void Renderer::dispatchCompute(Ref<VulkanComputePipeline> pipeline, Ref<VulkanDescriptorManager> dm, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        s_RendererAPI->dispatchCompute(pipeline, dm, groupCountX, groupCountY, groupCountZ);
+    }
+
     Ref<Texture2D> Renderer::getWhiteTexture()
     {
         return s_WhiteTexture;
     }
 
+    ShaderLibrary& Renderer::getShaderLibrary()
+    {
+        return s_ShaderLibrary;
+    }
+
+    PipelineLibrary& Renderer::getPipelineLibrary()
+    {
+        return s_PipelineLibrary;
+    }
+
+    ThreadPool& Renderer::getThreadPool()
+    {
+        AST_CORE_ASSERT(s_ThreadPool, "The renderer has not been initialized!");
+        return *s_ThreadPool;
+    }
+
+    VulkanDescriptorAllocator::Statistics Renderer::getDescriptorStats()
+    {
+        return VulkanContext::get()->getDevice()->getDescriptorAllocator()->getStats();
+    }
+
     //VkSampleCountFlagBits Renderer::getMaxUsableSampleCount()
     //{
     //    auto physicalDevice = VulkanContext::get()->getDevice()->getPhysicalDevice();
@@ -5,7 +5,9 @@
 #include "Astranox/rendering/Renderer.hpp"
 
 #include "Astranox/rendering/VertexBufferLayout.hpp"
+#include "Astranox/rendering/VertexBufferArray.hpp"
 #include "Astranox/rendering/Texture2D.hpp"
+#include "Astranox/rendering/QuadKernels.hpp"
 #include "Astranox/rendering/UniformBufferArray.hpp"
 
 #include "Astranox/platform/vulkan/VulkanShader.hpp"
@@ -14,6 +16,8 @@
 #include "Astranox/platform/vulkan/VulkanDescriptorManager.hpp"
 #include "Astranox/platform/vulkan/VulkanTexture2D.hpp"
 
+#include <bit>
+
 namespace Astranox
 {
     struct QuadVertex
@@ -25,53 +29,244 @@ namespace Astranox
         float tilingFactor;
     };
 
+    // Used by the instanced path, a quarter of the size of the four vertices of a quad.
+    struct QuadInstance
+    {
+        glm::vec3 position;
+        glm::vec2 size;
+        float rotation;  // Radians
+        glm::vec4 color;
+        float texIndex;
+        float tilingFactor;
+    };
+
     struct Renderer2DData
     {
+        // Limits of a single batch. A scene may contain any number of batches.
         static const uint32_t maxQuads = 10000;
         static const uint32_t maxVertices = maxQuads * 4;
         static const uint32_t maxIndices = maxQuads * 6;
-        static const uint32_t maxTextureSlots = 32;
+
+        Renderer2DSpecification specification;
 
         Ref<VulkanPipeline> pipeline;
         Ref<Shader> shader;
-        Ref<VulkanDescriptorManager> descriptorManager;
         Ref<UniformBufferArray> cameraUBA;
-        Ref<VertexBuffer> quadVB;
         Ref<IndexBuffer> quadIB;
         Ref<Texture2D> whiteTexture;
+        float whiteTextureIndex = 0.0f;
+
+        // [NOTE] Textures are sampled from the bindless texture table, so the descriptor sets only hold the camera
+        //      and are shared by all batches. They point at the frame's camera buffer and are rewritten by every scene,
+        //      so they come from the frame's transient pools.
+        Ref<VulkanDescriptorManager> descriptorManager;
+
+        // [NOTE] Each batch of a scene owns its vertex buffers,
+        // because all batches are recorded into the same command buffer before it is submitted.
+        // They are created on demand and reused by the following scenes.
+        // Vertex buffers are additionally duplicated per frame in flight and stay mapped,
+        // so quads are written straight into the buffer the GPU reads from.
+        std::vector<Ref<VertexBufferArray>> quadVBAs;
+        uint32_t batchIndex = 0;
 
         uint32_t quadIndexCount = 0;
         QuadVertex* quadVertexBufferBase = nullptr;
         QuadVertex* quadVertexBufferPtr = nullptr;
-
-        std::array<Ref<Texture2D>, maxTextureSlots> textureSlots;
-        uint32_t textureSlotIndex = 1;  // 0: white texture
+        QuadInstance* quadInstanceBufferBase = nullptr;
+        QuadInstance* quadInstanceBufferPtr = nullptr;
 
         glm::vec4 quadVertexPositions[4];
 
+        // Scratch memory of drawQuads()
+        QuadStreams quadStreams;
+        std::vector<glm::vec3> quadCorners;
+
         Renderer2D::Statistics stats;
     };
 
     static Renderer2DData* s_Data = nullptr;
 
-    void Renderer2D::init()
+    /**
+     * Create the vertex buffers used by the batch at `s_Data->batchIndex`.
+     */
+    static void createBatchResources()
+    {
+        uint32_t batchSize = s_Data->specification.instanced
+            ? Renderer2DData::maxQuads * sizeof(QuadInstance)
+            : Renderer2DData::maxVertices * sizeof(QuadVertex);
+        s_Data->quadVBAs.push_back(VertexBufferArray::create(batchSize));
+    }
+
+    static void startBatch()
+    {
+        if (s_Data->batchIndex >= s_Data->quadVBAs.size())
+        {
+            createBatchResources();
+        }
+
+        // Reset quad info
+        auto quadVB = s_Data->quadVBAs[s_Data->batchIndex]->getCurrentBuffer();
+        s_Data->quadIndexCount = 0;
+        if (s_Data->specification.instanced)
+        {
+            s_Data->quadInstanceBufferBase = static_cast<QuadInstance*>(quadVB->getMappedData());
+            s_Data->quadInstanceBufferPtr = s_Data->quadInstanceBufferBase;
+        }
+        else
+        {
+            s_Data->quadVertexBufferBase = static_cast<QuadVertex*>(quadVB->getMappedData());
+            s_Data->quadVertexBufferPtr = s_Data->quadVertexBufferBase;
+        }
+    }
+
+    /**
+     * Record the draw call of the current batch into the render pass that is already open.
+     */
+    static void flush()
+    {
+        if (s_Data->quadIndexCount == 0)
+        {
+            return;
+        }
+
+        auto quadVB = s_Data->quadVBAs[s_Data->batchIndex]->getCurrentBuffer();
+        auto& descriptorManager = s_Data->descriptorManager;
+
+        uint32_t quadDataSize = s_Data->specification.instanced
+            ? (uint32_t)((uint8_t*)s_Data->quadInstanceBufferPtr - (uint8_t*)s_Data->quadInstanceBufferBase)
+            : (uint32_t)((uint8_t*)s_Data->quadVertexBufferPtr - (uint8_t*)s_Data->quadVertexBufferBase);
+        quadVB->flush(quadDataSize);
+
+        auto swapchain = VulkanContext::get()->getSwapchain();
+        if (s_Data->specification.instanced)
+        {
+            // Every instance reuses the first 6 indices, the corners are selected by gl_VertexIndex.
+            Renderer::renderInstanced(
+                swapchain->getCurrentCommandBuffer(),
+                s_Data->pipeline,
+                descriptorManager,
+                nullptr,
+                quadVB,
+                s_Data->quadIB,
+                6,
+                s_Data->quadIndexCount / 6
+            );
+        }
+        else
+        {
+            Renderer::renderGeometry(
+                swapchain->getCurrentCommandBuffer(),
+                s_Data->pipeline,
+                descriptorManager,
+                quadVB,
+                s_Data->quadIB,
+                s_Data->quadIndexCount
+            );
+        }
+
+        s_Data->stats.drawCalls++;
+        s_Data->stats.batchQuadCounts.push_back(s_Data->quadIndexCount / 6);
+    }
+
+    static void nextBatch()
+    {
+        flush();
+        s_Data->batchIndex++;
+        startBatch();
+    }
+
+    /**
+     * Append a quad to the current batch.
+     * @param rotation Rotation around the z-axis, in radians.
+     */
+    static void submitQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color, float textureIndex, float tilingFactor)
+    {
+        if (s_Data->quadIndexCount >= Renderer2DData::maxIndices)
+        {
+            nextBatch();
+        }
+
+        if (s_Data->specification.instanced)
+        {
+            s_Data->quadInstanceBufferPtr->position = position;
+            s_Data->quadInstanceBufferPtr->size = size;
+            s_Data->quadInstanceBufferPtr->rotation = rotation;
+            s_Data->quadInstanceBufferPtr->color = color;
+            s_Data->quadInstanceBufferPtr->texIndex = textureIndex;
+            s_Data->quadInstanceBufferPtr->tilingFactor = tilingFactor;
+            s_Data->quadInstanceBufferPtr++;
+        }
+        else
+        {
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+            if (rotation != 0.0f)
+            {
+                transform *= glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f });
+            }
+            transform *= glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+            constexpr glm::vec2 texCoords[] = {
+                { 0.0f, 0.0f },
+                { 1.0f, 0.0f },
+                { 1.0f, 1.0f },
+                { 0.0f, 1.0f }
+            };
+
+            constexpr size_t quadVertexCount = 4;
+            for (size_t i = 0; i < quadVertexCount; ++i)
+            {
+                s_Data->quadVertexBufferPtr->position = transform * s_Data->quadVertexPositions[i];
+                s_Data->quadVertexBufferPtr->color = color;
+                s_Data->quadVertexBufferPtr->texCoord = texCoords[i];
+                s_Data->quadVertexBufferPtr->texIndex = textureIndex;
+                s_Data->quadVertexBufferPtr->tilingFactor = tilingFactor;
+                s_Data->quadVertexBufferPtr++;
+            }
+        }
+
+        s_Data->quadIndexCount += 6;
+
+        s_Data->stats.quadCount++;
+    }
+
+    void Renderer2D::init(const Renderer2DSpecification& specification)
     {
         s_Data = new Renderer2DData;
+        s_Data->specification = specification;
 
-        std::filesystem::path shaderPath = "assets/shaders/Texture.glsl";
-        s_Data->shader = VulkanShaderCompiler::compile(shaderPath);
+        // [NOTE] A shader file holds a single vertex stage, so the instanced path has its own shader.
+        std::filesystem::path shaderPath = specification.instanced
+            ? "assets/shaders/TextureInstanced.glsl"
+            : "assets/shaders/Texture.glsl";
+        // Loaded through the renderer's library, so that the shader can be hot reloaded.
+        ShaderLibrary& shaderLibrary = Renderer::getShaderLibrary();
+        std::string shaderName = shaderPath.stem().string();
+        s_Data->shader = shaderLibrary.exists(shaderName) ? shaderLibrary.get(shaderName) : shaderLibrary.load(shaderPath);
 
         // Vertex buffer >>>
-        VertexBufferLayout vertexBufferLayout{
-            {ShaderDataType::Vec3, "a_Position"},
-            {ShaderDataType::Vec4, "a_Color"},
-            {ShaderDataType::Vec2, "a_TexCoord"},
-            {ShaderDataType::Float, "a_TexIndex"},
-            {ShaderDataType::Float, "a_TilingFactor"}
-        };
-        s_Data->quadVB = VertexBuffer::create(Renderer2DData::maxVertices * sizeof(QuadVertex));
-
-        s_Data->quadVertexBufferBase = new QuadVertex[Renderer2DData::maxVertices];
+        VertexBufferLayout vertexBufferLayout;
+        VertexBufferLayout instanceBufferLayout;
+        if (specification.instanced)
+        {
+            instanceBufferLayout = {
+                {ShaderDataType::Vec3, "a_Position"},
+                {ShaderDataType::Vec2, "a_Size"},
+                {ShaderDataType::Float, "a_Rotation"},
+                {ShaderDataType::Vec4, "a_Color"},
+                {ShaderDataType::Float, "a_TexIndex"},
+                {ShaderDataType::Float, "a_TilingFactor"}
+            };
+        }
+        else
+        {
+            vertexBufferLayout = {
+                {ShaderDataType::Vec3, "a_Position"},
+                {ShaderDataType::Vec4, "a_Color"},
+                {ShaderDataType::Vec2, "a_TexCoord"},
+                {ShaderDataType::Float, "a_TexIndex"},
+                {ShaderDataType::Float, "a_TilingFactor"}
+            };
+        }
         // <<< Vertex buffer
 
         // Index buffer >>>
@@ -104,25 +299,28 @@ namespace Astranox
         // <<< Index buffer
 
         s_Data->whiteTexture = Renderer::getWhiteTexture();
-        s_Data->textureSlots[0] = s_Data->whiteTexture;
+        s_Data->whiteTextureIndex = (float)s_Data->whiteTexture->getID();
 
         PipelineSpecification pipelineSpec{
             .shader = s_Data->shader,
             .vertexBufferLayout = vertexBufferLayout,
+            .instanceBufferLayout = instanceBufferLayout,
             .depthTestEnable = true,
-            .depthWriteEnable = true
+            .depthWriteEnable = true,
+            .specializationConstants = {
+                { "c_AlphaTest", specification.alphaCutoff > 0.0f },
+                { "c_AlphaCutoff", std::bit_cast<uint32_t>(specification.alphaCutoff) },
+            },
         };
-        s_Data->pipeline = Ref<VulkanPipeline>::create(pipelineSpec);
+        s_Data->pipeline = Renderer::getPipelineLibrary().get(pipelineSpec);
 
         s_Data->cameraUBA = UniformBufferArray::create(sizeof(CameraData));
-        s_Data->descriptorManager = Ref<VulkanDescriptorManager>::create(s_Data->shader);
+
+        s_Data->descriptorManager = Ref<VulkanDescriptorManager>::create(s_Data->shader, true);
         s_Data->descriptorManager->setInput("u_Camera", s_Data->cameraUBA);
 
-        for (uint32_t i = 0; i < Renderer2DData::maxTextureSlots; ++i)
-        {
-            s_Data->descriptorManager->setInput("u_Textures", s_Data->whiteTexture, i);
-        }
-        s_Data->descriptorManager->upload();
+        // Resources of the first batch
+        createBatchResources();
 
         s_Data->quadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
         s_Data->quadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
@@ -132,9 +330,7 @@ namespace Astranox
 
     void Renderer2D::shutdown()
     {
-        auto device = VulkanContext::get()->getDevice();
-        device->waitIdle();
-
+        // [NOTE] No need to wait for the device: the GPU resources are released through the deletion queue.
         delete s_Data;
     }
 
@@ -145,65 +341,32 @@ namespace Astranox
         cameraData.viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
         s_Data->cameraUBA->getCurrentBuffer()->setData(&cameraData, sizeof(CameraData), 0);
 
-        // Reset quad info
-        s_Data->quadIndexCount = 0;
-        s_Data->quadVertexBufferPtr = s_Data->quadVertexBufferBase;
+        // Allocates this scene's sets from the frame's transient pools and writes the camera
+        s_Data->descriptorManager->upload();
 
-        // Reset texture slots
-        s_Data->textureSlotIndex = 1;
+        // [NOTE] The render pass stays open for the whole scene,
+        // so that full batches can be flushed into it while quads are being drawn.
+        auto swapchain = VulkanContext::get()->getSwapchain();
 
-        for (size_t i = 1; i < s_Data->textureSlots.size(); ++i)
-        {
-            s_Data->textureSlots[i] = nullptr;
-        }
+        Renderer::beginFrame();
+        Renderer::beginRenderPass(
+            swapchain->getCurrentCommandBuffer(),
+            swapchain->getRenderPass(),
+            s_Data->pipeline,
+            s_Data->descriptorManager->getDescriptorSets(Renderer::getCurrentFrameIndex())
+        );
+
+        s_Data->batchIndex = 0;
+        startBatch();
     }
 
     void Renderer2D::endScene()
     {
         auto swapchain = VulkanContext::get()->getSwapchain();
 
-        Renderer::beginFrame();
-
-        // Quad rendering
-        uint32_t quadDataSize = (uint32_t)((uint8_t*)s_Data->quadVertexBufferPtr - (uint8_t*)s_Data->quadVertexBufferBase);
-        if (quadDataSize > 0)
-        {
-            s_Data->quadVB->setData(s_Data->quadVertexBufferBase, quadDataSize);
-
-            for (uint32_t i = 0; i < s_Data->textureSlots.size(); ++i)
-            {
-                if (s_Data->textureSlots[i])
-                {
-                    s_Data->descriptorManager->setInput("u_Textures", s_Data->textureSlots[i], i);
-                }
-                else
-                {
-                    s_Data->descriptorManager->setInput("u_Textures", s_Data->whiteTexture, i);
-                }
-            }
-
-            Renderer::beginRenderPass(
-                swapchain->getCurrentCommandBuffer(),
-                swapchain->getRenderPass(),
-                s_Data->pipeline,
-                s_Data->descriptorManager->getDescriptorSets(Renderer::getCurrentFrameIndex())
-            );
-            //s_Data->descriptorManager->upload();
-
-            Renderer::renderGeometry(
-                swapchain->getCurrentCommandBuffer(),
-                s_Data->pipeline,
-                s_Data->descriptorManager,
-                s_Data->quadVB,
-                s_Data->quadIB,
-                s_Data->quadIndexCount
-            );
-
-            Renderer::endRenderPass(swapchain->getCurrentCommandBuffer());
-
-            s_Data->stats.drawCalls++;
-        }
+        flush();
 
+        Renderer::endRenderPass(swapchain->getCurrentCommandBuffer());
         Renderer::endFrame();
     }
 
@@ -218,31 +381,10 @@ namespace Astranox
 
     void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
     {
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-        const float textureIndex = 0.0f;  // White texture
+        const float textureIndex = s_Data->whiteTextureIndex;
         const float tilingFactor = 1.0f;
 
-        constexpr glm::vec2 texCoords[] = {
-            { 0.0f, 0.0f },
-            { 1.0f, 0.0f },
-            { 1.0f, 1.0f },
-            { 0.0f, 1.0f }
-        };
-
-        constexpr size_t quadVertexCount = 4;
-        for (size_t i = 0; i < quadVertexCount; ++i)
-        {
-            s_Data->quadVertexBufferPtr->position = transform * s_Data->quadVertexPositions[i];
-            s_Data->quadVertexBufferPtr->color = color;
-            s_Data->quadVertexBufferPtr->texCoord = texCoords[i];
-            s_Data->quadVertexBufferPtr->texIndex = textureIndex;
-            s_Data->quadVertexBufferPtr++;
-        }
-
-        s_Data->quadIndexCount += 6;
-
-        s_Data->stats.quadCount++;
+        submitQuad(position, size, 0.0f, color, textureIndex, tilingFactor);
     }
 
     void Renderer2D::drawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -252,49 +394,10 @@ namespace Astranox
 
     void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
     {
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+        // The texture ID is its index in the bindless texture table.
+        float textureIndex = (float)texture->getID();
 
-        // Find texture index
-        float textureIndex = 0.0f;
-        for (uint32_t i = 1; i < s_Data->textureSlotIndex; ++i)
-        {
-            if (*s_Data->textureSlots[i].raw() == *texture.raw())
-            {
-                textureIndex = (float)i;
-                break;
-            }
-        }
-
-        // If texture is not found, insert it into the texture slots
-        if (textureIndex == 0.0f)
-        {
-            textureIndex = (float)s_Data->textureSlotIndex;
-            s_Data->textureSlots[s_Data->textureSlotIndex] = texture;
-            s_Data->textureSlotIndex++;
-        }
-
-        constexpr glm::vec2 texCoords[] = {
-            { 0.0f, 0.0f },
-            { 1.0f, 0.0f },
-            { 1.0f, 1.0f },
-            { 0.0f, 1.0f }
-        };
-        constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-        constexpr size_t quadVertexCount = 4;
-        for (size_t i = 0; i < quadVertexCount; ++i)
-        {
-            s_Data->quadVertexBufferPtr->position = transform * s_Data->quadVertexPositions[i];
-            s_Data->quadVertexBufferPtr->color = { 1.0f, 1.0f, 1.0f, 1.0f };
-            s_Data->quadVertexBufferPtr->texCoord = texCoords[i];
-            s_Data->quadVertexBufferPtr->texIndex = textureIndex;
-            s_Data->quadVertexBufferPtr->tilingFactor = tilingFactor;
-            s_Data->quadVertexBufferPtr++;
-        }
-
-        s_Data->quadIndexCount += 6;
-
-        s_Data->stats.quadCount++;
+        submitQuad(position, size, 0.0f, tintColor, textureIndex, tilingFactor);
     }
 
     void Renderer2D::drawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float degrees, const glm::vec4& color)
@@ -304,11 +407,15 @@ namespace Astranox
 
     void Renderer2D::drawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float degrees, const glm::vec4& color)
     {
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-            * glm::rotate(glm::mat4(1.0f), glm::radians(degrees), { 0.0f, 0.0f, 1.0f })
-            * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+        const float textureIndex = s_Data->whiteTextureIndex;
+        const float tilingFactor = 1.0f;
+
+        submitQuad(position, size, glm::radians(degrees), color, textureIndex, tilingFactor);
+    }
 
-        const float textureIndex = 0.0f;  // White texture
+    void Renderer2D::drawQuads(std::span<const QuadDesc> quads)
+    {
+        const float textureIndex = s_Data->whiteTextureIndex;
         const float tilingFactor = 1.0f;
 
         constexpr glm::vec2 texCoords[] = {
@@ -318,19 +425,84 @@ namespace Astranox
             { 0.0f, 1.0f }
         };
 
-        constexpr size_t quadVertexCount = 4;
-        for (size_t i = 0; i < quadVertexCount; ++i)
+        size_t first = 0;
+        while (first < quads.size())
         {
-            s_Data->quadVertexBufferPtr->position = transform * s_Data->quadVertexPositions[i];
-            s_Data->quadVertexBufferPtr->color = color;
-            s_Data->quadVertexBufferPtr->texCoord = texCoords[i];
-            s_Data->quadVertexBufferPtr->texIndex = textureIndex;
-            s_Data->quadVertexBufferPtr++;
-        }
+            if (s_Data->quadIndexCount >= Renderer2DData::maxIndices)
+            {
+                nextBatch();
+            }
 
-        s_Data->quadIndexCount += 6;
+            // Fill the rest of the current batch
+            size_t capacity = (Renderer2DData::maxIndices - s_Data->quadIndexCount) / 6;
+            size_t count = std::min(capacity, quads.size() - first);
+            std::span<const QuadDesc> chunk = quads.subspan(first, count);
 
-        s_Data->stats.quadCount++;
+            if (s_Data->specification.instanced)
+            {
+                // The vertex shader expands the corners, nothing to compute here.
+                for (const QuadDesc& quad : chunk)
+                {
+                    s_Data->quadInstanceBufferPtr->position = quad.position;
+                    s_Data->quadInstanceBufferPtr->size = quad.size;
+                    s_Data->quadInstanceBufferPtr->rotation = glm::radians(quad.rotation);
+                    s_Data->quadInstanceBufferPtr->color = quad.color;
+                    s_Data->quadInstanceBufferPtr->texIndex = textureIndex;
+                    s_Data->quadInstanceBufferPtr->tilingFactor = tilingFactor;
+                    s_Data->quadInstanceBufferPtr++;
+                }
+            }
+            else
+            {
+                // AoS -> SoA
+                QuadStreams& streams = s_Data->quadStreams;
+                streams.resize(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const QuadDesc& quad = chunk[i];
+                    streams.positionX[i] = quad.position.x;
+                    streams.positionY[i] = quad.position.y;
+                    streams.positionZ[i] = quad.position.z;
+                    streams.halfWidth[i] = 0.5f * quad.size.x;
+                    streams.halfHeight[i] = 0.5f * quad.size.y;
+
+                    if (quad.rotation == 0.0f)
+                    {
+                        streams.sin[i] = 0.0f;
+                        streams.cos[i] = 1.0f;
+                    }
+                    else
+                    {
+                        float radians = glm::radians(quad.rotation);
+                        streams.sin[i] = std::sin(radians);
+                        streams.cos[i] = std::cos(radians);
+                    }
+                }
+
+                // [NOTE] The corners go to scratch memory first, so that the mapped vertex buffer
+                //      (possibly write-combined) is written once, sequentially and in whole vertices.
+                s_Data->quadCorners.resize(count * 4);
+                QuadKernels::computeCorners(streams, 0, count, s_Data->quadCorners.data(), sizeof(glm::vec3));
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        s_Data->quadVertexBufferPtr->position = s_Data->quadCorners[4 * i + j];
+                        s_Data->quadVertexBufferPtr->color = chunk[i].color;
+                        s_Data->quadVertexBufferPtr->texCoord = texCoords[j];
+                        s_Data->quadVertexBufferPtr->texIndex = textureIndex;
+                        s_Data->quadVertexBufferPtr->tilingFactor = tilingFactor;
+                        s_Data->quadVertexBufferPtr++;
+                    }
+                }
+            }
+
+            s_Data->quadIndexCount += static_cast<uint32_t>(count * 6);
+            s_Data->stats.quadCount += static_cast<uint32_t>(count);
+
+            first += count;
+        }
     }
 
     Renderer2D::Statistics Renderer2D::getStats() const
@@ -342,5 +514,6 @@ namespace Astranox
     {
         s_Data->stats.drawCalls = 0;
         s_Data->stats.quadCount = 0;
+        s_Data->stats.batchQuadCounts.clear();
     }
 }
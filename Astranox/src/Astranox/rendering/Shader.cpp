@@ -1,10 +1,25 @@
 #include "pch.hpp"
 #include "Astranox/rendering/Shader.hpp"
+#include "Astranox/rendering/Renderer.hpp"
 #include "Astranox/rendering/RendererAPI.hpp"
 #include "Astranox/platform/vulkan/VulkanShader.hpp"
+#include "Astranox/platform/vulkan/VulkanShaderCompiler.hpp"
 
 namespace Astranox
 {
+    namespace Utils
+    {
+        static ShaderDefines keywordsToDefines(const std::vector<std::string>& keywords)
+        {
+            ShaderDefines defines;
+            for (const auto& keyword : keywords)
+            {
+                defines[keyword] = "1";
+            }
+            return defines;
+        }
+    }
+
     Ref<Shader> Shader::create()
     {
         switch (RendererAPI::getType())
@@ -17,7 +32,10 @@ namespace Astranox
         return nullptr;
     }
 
-
+    ShaderLibrary::~ShaderLibrary()
+    {
+        clear();
+    }
 
     void ShaderLibrary::add(Ref<Shader> shader)
     {
@@ -35,13 +53,213 @@ namespace Astranox
     {
         auto shader = VulkanShaderCompiler::compile(filepath);
         add(shader);
+
+        m_Filepaths[shader->getName()] = filepath;
+        watchSources(shader->getName());
+
         return shader;
     }
 
+    std::vector<Ref<Shader>> ShaderLibrary::loadAll(const std::vector<std::filesystem::path>& filepaths)
+    {
+        std::vector<Ref<Shader>> shaders;
+        shaders.reserve(filepaths.size());
+
+        std::vector<Ref<VulkanShader>> compiledShaders = VulkanShaderCompiler::compileBatch(filepaths);
+        for (size_t i = 0; i < compiledShaders.size(); ++i)
+        {
+            Ref<VulkanShader> shader = compiledShaders[i];
+            AST_CORE_ASSERT(shader, "Failed to compile shader {0}!", filepaths[i].string());
+
+            add(shader);
+            shaders.push_back(shader);
+
+            m_Filepaths[shader->getName()] = filepaths[i];
+            watchSources(shader->getName());
+        }
+        return shaders;
+    }
+
     Ref<Shader> ShaderLibrary::get(const std::string& name)
     {
         AST_CORE_ASSERT(m_Shaders.find(name) != m_Shaders.end(), "Shader not found!");
         return m_Shaders[name];
     }
-}
 
+    Ref<Shader> ShaderLibrary::getVariant(const std::string& name, std::vector<std::string> keywords)
+    {
+        // Sorted, so that the same keywords in any order name the same variant.
+        std::sort(keywords.begin(), keywords.end());
+        keywords.erase(std::unique(keywords.begin(), keywords.end()), keywords.end());
+        if (keywords.empty())
+        {
+            return get(name);
+        }
+
+        std::string variantName = name + "#";
+        for (size_t i = 0; i < keywords.size(); ++i)
+        {
+            variantName += (i == 0 ? "" : "+") + keywords[i];
+        }
+
+        auto it = m_Shaders.find(variantName);
+        if (it != m_Shaders.end())
+        {
+            return it->second;
+        }
+
+        AST_CORE_ASSERT(m_Filepaths.find(name) != m_Filepaths.end(), "Variants require shader {0} to be loaded from a file!", name);
+
+        const auto& declaredKeywords = get(name).as<VulkanShader>()->getKeywords();
+        for (const auto& keyword : keywords)
+        {
+            AST_CORE_ASSERT(std::find(declaredKeywords.begin(), declaredKeywords.end(), keyword) != declaredKeywords.end(),
+                "Shader {0} does not declare keyword {1}!", name, keyword);
+        }
+
+        std::filesystem::path filepath = m_Filepaths.at(name);
+        Ref<Shader> shader = VulkanShaderCompiler::compile(filepath, Utils::keywordsToDefines(keywords));
+        add(variantName, shader);
+
+        m_Filepaths[variantName] = filepath;
+        m_VariantKeywords[variantName] = keywords;
+
+        // [NOTE] Keywords may guard `#include`s, so a variant can depend on files its base shader does not.
+        watchSources(variantName);
+
+        return shader;
+    }
+
+    void ShaderLibrary::clear()
+    {
+        // Recompiled shaders must not outlive the library's Vulkan objects.
+        if (!m_PendingReloads.empty())
+        {
+            Renderer::getThreadPool().waitIdle();
+            m_PendingReloads.clear();
+        }
+
+        m_FileWatcher.unwatchAll();
+        m_Filepaths.clear();
+        m_VariantKeywords.clear();
+        m_Shaders.clear();
+    }
+
+    void ShaderLibrary::update()
+    {
+        if (!m_HotReload)
+        {
+            return;
+        }
+
+        for (const auto& changedFilepath : m_FileWatcher.poll())
+        {
+            // An edited header reloads every shader that includes it.
+            for (auto& [name, filepath] : m_Filepaths)
+            {
+                const auto& dependencies = m_Shaders.at(name).as<VulkanShader>()->getDependencies();
+                if (filepath == changedFilepath
+                    || std::find(dependencies.begin(), dependencies.end(), changedFilepath) != dependencies.end())
+                {
+                    requestReload(name);
+                }
+            }
+        }
+
+        for (auto it = m_PendingReloads.begin(); it != m_PendingReloads.end(); )
+        {
+            auto& [name, pending] = *it;
+            if (pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            Ref<Shader> recompiled = pending.future.get();
+            bool stale = pending.stale;
+            std::string shaderName = name;
+            it = m_PendingReloads.erase(it);
+
+            if (stale)
+            {
+                requestReload(shaderName);
+                continue;
+            }
+
+            if (!recompiled)
+            {
+                AST_CORE_ERROR("Failed to reload shader {0}, keeping the previous version.", shaderName);
+                continue;
+            }
+
+            // [NOTE] Pipelines compiling in the background read the shader, so those of this shader are waited for before the swap.
+            Ref<Shader> shader = m_Shaders.at(shaderName);
+            Renderer::getPipelineLibrary().waitPending(shader);
+
+            std::vector<std::filesystem::path> previousDependencies = shader.as<VulkanShader>()->getDependencies();
+            if (shader.as<VulkanShader>()->reload(recompiled.as<VulkanShader>()))
+            {
+                uint32_t pipelineCount = Renderer::getPipelineLibrary().invalidate(shader);
+                AST_CORE_INFO("Reloaded shader {0} ({1} pipelines rebuilt).", shaderName, pipelineCount);
+
+                // The edit may have added or dropped includes.
+                watchSources(shaderName);
+                unwatchUnused(previousDependencies);
+            }
+        }
+    }
+
+    void ShaderLibrary::watchSources(const std::string& name)
+    {
+        m_FileWatcher.watch(m_Filepaths.at(name));
+        for (const auto& dependency : m_Shaders.at(name).as<VulkanShader>()->getDependencies())
+        {
+            m_FileWatcher.watch(dependency);
+        }
+    }
+
+    void ShaderLibrary::unwatchUnused(const std::vector<std::filesystem::path>& filepaths)
+    {
+        for (const auto& filepath : filepaths)
+        {
+            bool used = std::any_of(m_Filepaths.begin(), m_Filepaths.end(),
+                [this, &filepath](const auto& entry) {
+                    const auto& dependencies = m_Shaders.at(entry.first).as<VulkanShader>()->getDependencies();
+                    return entry.second == filepath
+                        || std::find(dependencies.begin(), dependencies.end(), filepath) != dependencies.end();
+                });
+
+            if (!used)
+            {
+                m_FileWatcher.unwatch(filepath);
+            }
+        }
+    }
+
+    void ShaderLibrary::requestReload(const std::string& name)
+    {
+        auto it = m_PendingReloads.find(name);
+        if (it != m_PendingReloads.end())
+        {
+            it->second.stale = true;
+            return;
+        }
+
+        AST_CORE_INFO("Shader {0} changed, recompiling...", name);
+
+        std::filesystem::path filepath = m_Filepaths.at(name);
+
+        ShaderDefines defines;
+        auto keywordsIt = m_VariantKeywords.find(name);
+        if (keywordsIt != m_VariantKeywords.end())
+        {
+            defines = Utils::keywordsToDefines(keywordsIt->second);
+        }
+
+        m_PendingReloads[name].future = Renderer::getThreadPool().submit(
+            [filepath, defines]() -> Ref<Shader> {
+                return VulkanShaderCompiler::compileBatch({ filepath }, defines)[0];
+            }
+        );
+    }
+}
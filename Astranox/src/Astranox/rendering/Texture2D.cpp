@@ -1,9 +1,37 @@
 #include "pch.hpp"
 #include "Astranox/platform/vulkan/VulkanTexture2D.hpp"
+#include "Astranox/platform/vulkan/VulkanContext.hpp"
 #include "Astranox/rendering/RendererAPI.hpp"
+#include "Astranox/rendering/Renderer.hpp"
 
 namespace Astranox
 {
+    // Texture ID >>>
+    // IDs are the elements of the bindless texture table, which hands them out and recycles them.
+    Texture2D::Texture2D()
+    {
+        m_ID = VulkanContext::get()->getBindlessTextureRegistry()->allocateIndex();
+        if (m_ID == VulkanBindlessTextureRegistry::s_InvalidIndex)
+        {
+            // [NOTE] The white texture is created first, so it always has an element of its own.
+            Ref<Texture2D> whiteTexture = Renderer::getWhiteTexture();
+            AST_CORE_ASSERT(whiteTexture, "The bindless texture table is full!");
+
+            AST_CORE_ERROR("The bindless texture table is full, the texture is replaced by the white texture.");
+            m_ID = whiteTexture->getID();
+            m_OwnsID = false;
+        }
+    }
+
+    Texture2D::~Texture2D()
+    {
+        if (m_OwnsID)
+        {
+            VulkanContext::get()->getBindlessTextureRegistry()->releaseIndex(m_ID);
+        }
+    }
+    // <<< Texture ID
+
     Ref<Texture2D> Texture2D::create(const std::filesystem::path& path, bool enableMipMaps)
     {
         switch (RendererAPI::getType())
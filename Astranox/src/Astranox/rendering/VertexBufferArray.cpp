@@ -0,0 +1,20 @@
+#include "pch.hpp"
+#include "Astranox/rendering/VertexBufferArray.hpp"
+#include "Astranox/rendering/RendererAPI.hpp"
+
+#include "Astranox/platform/vulkan/VulkanVertexBufferArray.hpp"
+
+namespace Astranox
+{
+    Ref<VertexBufferArray> VertexBufferArray::create(uint32_t bytes)
+    {
+        switch (RendererAPI::getType())
+        {
+            case RendererAPI::Type::None:  { AST_CORE_ASSERT(false, "RendererAPI::None is not supported!"); break; }
+            case RendererAPI::Type::Vulkan: { return Ref<VulkanVertexBufferArray>::create(bytes); }
+        }
+
+        AST_CORE_ASSERT(false, "Unknown Renderer API!");
+        return nullptr;
+    }
+}
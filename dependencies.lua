@@ -30,6 +30,11 @@ dependencies = {
 			libName = "vulkan-1",
 			libDir = "%{VULKAN_SDK}/Lib/",
 		},
+		linux = {
+			libName = "vulkan",
+			libDir = "%{VULKAN_SDK}/lib/",
+			includeDir = "%{VULKAN_SDK}/include/",
+		},
 		includeDir = "%{VULKAN_SDK}/Include/",
 	},
 	glfw = {